@@ -628,8 +628,9 @@ Agnus::eolHandler()
     sequencer.eolHandler();
     denise.eolHandler();
 
-    // Clear the bus usage table
+    // Clear the bus usage tables
     for (isize i = 0; i < HPOS_CNT; i++) busOwner[i] = BUS_NONE;
+    for (isize i = 0; i < HPOS_CNT; i++) busValue[i] = 0;
 
     // Schedule the first BPL and DAS events
     scheduleFirstBplEvent();
@@ -650,6 +651,9 @@ Agnus::eofHandler()
     // Synthesize sound samples
     paula.executeUntil(clock - 50 * DMA_CYCLES(HPOS_CNT_PAL)); // MOVE TO Paula::eofHandler
 
+    // Publish the completed frame in shared memory
+    denise.frameExport.eofHandler();
+
     scheduleStrobe0Event();
 
     // Let other components do their own EOF stuff
@@ -679,7 +683,7 @@ Agnus::hsyncHandler()
     dmaDebugger.hsyncHandler(vpos);
 
     // Encode a LORES marker in the first HBLANK pixel
-    REPLACE_BIT(*pixelEngine.workingPtr(vpos), 28, res != LORES);
+    pixelEngine.setHiresMarker(vpos, res != LORES);
 
     // Call the vsyncHandler once we've finished a frame
     if (pos.v == 0) vsyncHandler();
@@ -574,7 +574,7 @@ Agnus::serviceDASEvent(EventID id)
 
             if (audxDR[0]) {
                 audxDR[0] = false;
-                paula.channel0.pokeAUDxDAT(doAudioDmaRead<0>());
+                paula.channel0.pokeAUDxDAT<ACCESSOR_AGNUS>(doAudioDmaRead<0>());
             }
             break;
 
@@ -582,7 +582,7 @@ Agnus::serviceDASEvent(EventID id)
 
             if (audxDR[1]) {
                 audxDR[1] = false;
-                paula.channel1.pokeAUDxDAT(doAudioDmaRead<1>());
+                paula.channel1.pokeAUDxDAT<ACCESSOR_AGNUS>(doAudioDmaRead<1>());
             }
             break;
 
@@ -600,7 +600,7 @@ Agnus::serviceDASEvent(EventID id)
 
             if (audxDR[2]) {
                 audxDR[2] = false;
-                paula.channel2.pokeAUDxDAT(doAudioDmaRead<2>());
+                paula.channel2.pokeAUDxDAT<ACCESSOR_AGNUS>(doAudioDmaRead<2>());
             }
             break;
 
@@ -608,7 +608,7 @@ Agnus::serviceDASEvent(EventID id)
 
             if (audxDR[3]) {
                 audxDR[3] = false;
-                paula.channel3.pokeAUDxDAT(doAudioDmaRead<3>());
+                paula.channel3.pokeAUDxDAT<ACCESSOR_AGNUS>(doAudioDmaRead<3>());
             }
             break;
 
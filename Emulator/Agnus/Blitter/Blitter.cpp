@@ -18,27 +18,6 @@ namespace vamiga {
 
 Blitter::Blitter(Amiga& ref) : SubComponent(ref)
 {
-    // Initialize the fill pattern tables
-    for (isize carryIn = 0; carryIn < 2; carryIn++) {
-        
-        for (isize byte = 0; byte < 256; byte++) {
-            
-            u8 carry = (u8)carryIn;
-            u8 inclPattern = (u8)byte;
-            u8 exclPattern = (u8)byte;
-            
-            for (isize bit = 0; bit < 8; bit++) {
-                
-                inclPattern |= carry << bit; // inclusive fill
-                exclPattern ^= carry << bit; // exclusive fill
-                
-                if (byte & (1 << bit)) carry = !carry;
-            }
-            fillPattern[0][carryIn][byte] = inclPattern;
-            fillPattern[1][carryIn][byte] = exclPattern;
-            nextCarryIn[carryIn][byte] = carry;
-        }
-    }
 }
 
 void
@@ -423,18 +402,24 @@ Blitter::doFill(u16 &data, bool &carry) const
     assert(carry == 0 || carry == 1);
 
     trace(BLT_DEBUG, "data = %X carry = %X\n", data, carry);
-    
-    u8 dataHi = HI_BYTE(data);
-    u8 dataLo = LO_BYTE(data);
-    u8 exclusive = !!bltconEFE();
-    
-    // Remember: A fill operation is carried out from right to left
-    u8 resultLo = fillPattern[exclusive][carry][dataLo];
-    carry = nextCarryIn[carry][dataLo];
-    u8 resultHi = fillPattern[exclusive][carry][dataHi];
-    carry = nextCarryIn[carry][dataHi];
-    
-    data = HI_LO(resultHi, resultLo);
+
+    /* A fill operation is carried out from right to left. The fill state at
+     * bit i is the carry-in XORed with all data bits to the right of bit i.
+     * Hence, all states of a word can be computed at once with a prefix XOR.
+     */
+    u16 prefix = data;
+    prefix ^= prefix << 1;
+    prefix ^= prefix << 2;
+    prefix ^= prefix << 4;
+    prefix ^= prefix << 8;
+
+    u16 state = (u16)(prefix << 1) ^ (carry ? 0xFFFF : 0);
+
+    // Compute the carry for the next word
+    carry ^= prefix >> 15;
+
+    // Apply the fill pattern
+    data = bltconEFE() ? (data ^ state) : (data | state);
 }
 
 void
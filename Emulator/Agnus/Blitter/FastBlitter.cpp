@@ -185,6 +185,11 @@ Blitter::doFastLineBlit()
     bool useC = bltcon0 & BLTCON0_USEC;
     bool sing = bltcon1 & BLTCON1_SING;
     bool sign = bltcon1 & BLTCON1_SIGN;
+    bool sud = bltcon1 & BLTCON1_SUD;
+    bool sul = bltcon1 & BLTCON1_SUL;
+    bool aul = bltcon1 & BLTCON1_AUL;
+    bool useA = bltcon0 & BLTCON0_USEA;
+    u8 minterm = bltcon0 & 0xFF;
     auto ash = bltconASH();
     auto bsh = bltconBSH();
 
@@ -215,39 +220,19 @@ Blitter::doFastLineBlit()
     auto doLineLogic = [&]() {
         
         firstPixel = false;
-        
+
+        // Step along the minor axis
         if (!sign) {
-            if (bltcon1 & BLTCON1_SUD) {
-                if (bltcon1 & BLTCON1_SUL)
-                    decy();
-                else
-                    incy();
-            } else {
-                if (bltcon1 & BLTCON1_SUL)
-                    decx();
-                else
-                    incx();
-            }
-        }
-        
-        if (bltcon1 & BLTCON1_SUD) {
-            if (bltcon1 & BLTCON1_AUL)
-                decx();
-            else
-                incx();
-        } else {
-            if (bltcon1 & BLTCON1_AUL)
-                decy();
-            else
-                incy();
-        }
-        
-        if (bltcon0 & BLTCON0_USEA) {
-            if (sign)
-                U32_INC(bltapt, bltbmod);
-            else
-                U32_INC(bltapt, bltamod);
+            if (sud) { if (sul) decy(); else incy(); }
+            else     { if (sul) decx(); else incx(); }
         }
+
+        // Step along the major axis
+        if (sud) { if (aul) decx(); else incx(); }
+        else     { if (aul) decy(); else incy(); }
+
+        // Update the error term
+        if (useA) U32_INC(bltapt, sign ? bltbmod : bltamod);
         
         sign = (i16)bltapt < 0;
     };
@@ -277,7 +262,7 @@ Blitter::doFastLineBlit()
         if (bsh-- == 0) bsh = 15;
         
         // Run the minterm circuit
-        dhold = doMintermLogic(ahold, (bhold & 1) ? 0xFFFF : 0, chold, bltcon0 & 0xFF);
+        dhold = doMintermLogic(ahold, (bhold & 1) ? 0xFFFF : 0, chold, minterm);
 
         bool writeEnable = (!sing || firstPixel) && useC;
 
@@ -105,41 +105,65 @@ Copper::findMatchOld(Beam &match) const
 bool
 Copper::findMatch(Beam &match) const
 {
-    // Start searching at the current beam position
-    u32 beam = (u32)(agnus.pos.v << 8 | agnus.pos.h);
-
     // Get the comparison position and the comparison mask
     u32 comp = getVPHP();
     u32 mask = getVMHM();
 
-    // Iterate through all lines starting from the current position
-    isize numLines = agnus.pos.vCnt();
-    while ((isize)(beam >> 8) < numLines) {
+    // Extract the vertical components
+    u32 vcomp = comp & mask & ~0xFF;
+    u32 vmask = mask & ~0xFF;
 
-        // Check if the vertical components are equal
-        if ((beam & mask & ~0xFF) == (comp & mask & ~0xFF)) {
+    // Start searching at the current beam position
+    u32 v = (u32)(agnus.pos.v << 8);
+    u32 h = (u32)(agnus.pos.h);
 
-            // Try to match the horizontal coordinate as well
-            if (findHorizontalMatch(beam, comp, mask)) {
+    // Check the current line
+    if ((v & vmask) > vcomp) {
 
-                // Success
-                match.v = beam >> 8;
-                match.h = beam & 0xFF;
-                return true;
-            }
-        }
+        match.v = agnus.pos.v;
+        match.h = agnus.pos.h;
+        return true;
+    }
+    if ((v & vmask) == vcomp) {
 
-        // Check if the vertical beam position is greater
-        else if ((beam & mask & ~0xFF) > (comp & mask & ~0xFF)) {
+        u32 beam = v | h;
+        if (findHorizontalMatch(beam, comp, mask)) {
 
-            // Success
             match.v = beam >> 8;
             match.h = beam & 0xFF;
             return true;
         }
+    }
 
-        // Jump to the beginning of the next line
-        beam = (beam & ~0xFF) + 0x100;
+    /* All remaining lines are entered at horizontal position 0. If the
+     * vertical components are equal, the outcome of the horizontal search
+     * only depends on the horizontal bits of 'comp' and 'mask'. Hence, we
+     * run the horizontal search once and reuse the result for all lines.
+     */
+    u32 hbeam = 0;
+    bool hmatch = findHorizontalMatch(hbeam, comp & 0xFF, mask & 0xFF);
+
+    // Iterate through all remaining lines
+    isize numLines = agnus.pos.vCnt();
+    for (isize line = agnus.pos.v + 1; line < numLines; line++) {
+
+        v = (u32)(line << 8);
+
+        // Check if the vertical beam position is greater
+        if ((v & vmask) > vcomp) {
+
+            match.v = line;
+            match.h = 0;
+            return true;
+        }
+
+        // Check if the vertical components are equal
+        if ((v & vmask) == vcomp && hmatch) {
+
+            match.v = line;
+            match.h = hbeam & 0xFF;
+            return true;
+        }
     }
 
     return false;
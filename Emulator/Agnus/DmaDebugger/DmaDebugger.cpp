@@ -10,6 +10,7 @@
 #include "config.h"
 #include "DmaDebugger.h"
 #include "Amiga.h"
+#include "IOUtils.h"
 
 namespace vamiga {
 
@@ -305,6 +306,9 @@ DmaDebugger::setColor(BusOwner owner, u32 rgba)
 void
 DmaDebugger::eolHandler()
 {
+    // Record the DMA trace
+    if (traceFile.is_open()) recordTraceLine();
+
     // Only proceed if DMA debugging has been turned on
     if (!config.enabled) return;
 
@@ -424,7 +428,185 @@ DmaDebugger::vSyncHandler()
 void
 DmaDebugger::eofHandler()
 {
+    // Write the recorded lines to the trace file
+    if (traceFile.is_open()) flushTrace();
+}
+
+void
+DmaDebugger::startTrace(const string &path)
+{
+    SUSPENDED
+
+    closeTrace();
+
+    traceFile.open(path, std::ios::binary);
+    if (!traceFile.is_open()) throw VAError(ERROR_FILE_CANT_WRITE, path);
+
+    // Write the file header
+    u8 header[] = {
+        'V', 'A', 'D', 'T',
+        u8(traceVersion), u8(traceVersion >> 8),
+        u8(HPOS_CNT), u8(HPOS_CNT >> 8)
+    };
+    traceFile.write((const char *)header, sizeof(header));
+
+    traceBuffer.clear();
+    traceBuffer.reserve(VPOS_CNT * (2 + 3 * HPOS_CNT));
+    traceLines = 0;
+    traceFrames = 0;
+}
+
+void
+DmaDebugger::stopTrace()
+{
+    SUSPENDED
+
+    closeTrace();
+}
+
+void
+DmaDebugger::closeTrace()
+{
+    if (traceFile.is_open()) {
+
+        debug(DMA_DEBUG, "%lld frames written to the trace file\n", traceFrames);
+        traceFile.close();
+    }
+    traceBuffer.clear();
+    traceLines = 0;
+}
+
+void
+DmaDebugger::recordTraceLine()
+{
+    auto v = agnus.pos.v;
+
+    traceBuffer.push_back(u8(v));
+    traceBuffer.push_back(u8(v >> 8));
+
+    for (isize i = 0; i < HPOS_CNT; i++) {
+        traceBuffer.push_back(u8(agnus.busOwner[i]));
+    }
+    for (isize i = 0; i < HPOS_CNT; i++) {
+        traceBuffer.push_back(u8(agnus.busValue[i]));
+        traceBuffer.push_back(u8(agnus.busValue[i] >> 8));
+    }
+
+    traceLines++;
+}
 
+void
+DmaDebugger::flushTrace()
+{
+    auto frame = agnus.pos.frame - 1;
+
+    // Write the frame header
+    u8 header[10];
+    for (isize i = 0; i < 8; i++) header[i] = u8(frame >> (8 * i));
+    header[8] = u8(traceLines);
+    header[9] = u8(traceLines >> 8);
+    traceFile.write((const char *)header, sizeof(header));
+
+    // Write all recorded lines in a single chunk
+    traceFile.write((const char *)traceBuffer.data(), traceBuffer.size());
+
+    if (!traceFile.good()) {
+
+        warn("Failed to write the DMA trace file\n");
+        closeTrace();
+        return;
+    }
+
+    traceBuffer.clear();
+    traceLines = 0;
+    traceFrames++;
+}
+
+void
+DmaDebugger::analyzeTrace(const string &path, std::ostream &os)
+{
+    using namespace util;
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) throw VAError(ERROR_FILE_NOT_FOUND, path);
+
+    auto read16 = [&]() { u8 b[2] = { }; file.read((char *)b, 2); return u16(b[0] | b[1] << 8); };
+    auto read64 = [&]() {
+        u8 b[8] = { }; file.read((char *)b, 8);
+        u64 result = 0;
+        for (isize i = 7; i >= 0; i--) result = result << 8 | b[i];
+        return i64(result);
+    };
+
+    // Check the file header
+    char magic[4] = { };
+    file.read(magic, 4);
+    if (!file.good() || std::memcmp(magic, "VADT", 4) != 0) {
+        throw VAError(ERROR_FILE_TYPE_MISMATCH, path);
+    }
+    auto version = read16();
+    auto slots = read16();
+    if (version != traceVersion || slots == 0) {
+        throw VAError(ERROR_FILE_TYPE_UNSUPPORTED, path);
+    }
+
+    i64 usage[BUS_COUNT] = { };
+    i64 frames = 0, lines = 0, busiest = 0, busiestFrame = 0;
+    i64 first = 0, last = 0;
+    std::vector<u8> line(2 * 3 * slots);
+
+    while (true) {
+
+        // Read the frame header
+        auto frame = read64();
+        auto count = read16();
+        if (!file.good()) break;
+
+        if (frames == 0) first = frame;
+        last = frame;
+
+        // Read all lines of this frame
+        i64 used = 0;
+        for (isize i = 0; i < count; i++) {
+
+            file.read((char *)line.data(), 2 + 3 * slots);
+            if (!file.good()) break;
+
+            for (isize j = 0; j < slots; j++) {
+
+                auto owner = line[2 + j];
+                if (owner < BUS_COUNT) usage[owner]++;
+                if (owner != BUS_NONE) used++;
+            }
+        }
+        if (!file.good()) break;
+
+        if (used > busiest) { busiest = used; busiestFrame = frame; }
+        lines += count;
+        frames++;
+    }
+
+    auto total = lines * slots;
+    auto percentage = [&](i64 value) { return total ? 100.0 * value / total : 0.0; };
+
+    os << tab("Frames");
+    os << dec(frames) << " (" << dec(first) << " - " << dec(last) << ")" << std::endl;
+    os << tab("Lines");
+    os << dec(lines) << std::endl;
+    os << tab("DMA slots");
+    os << dec(total) << std::endl;
+    os << tab("Bus utilization");
+    os << flt(percentage(total - usage[BUS_NONE])) << " %" << std::endl;
+    os << tab("Busiest frame");
+    os << dec(busiestFrame) << " (" << dec(busiest) << " slots)" << std::endl;
+    os << std::endl;
+
+    for (isize i = 0; i < BUS_COUNT; i++) {
+
+        if (usage[i] == 0) continue;
+        os << tab(BusOwnerEnum::key(BusOwner(i)));
+        os << dec(usage[i]) << " (" << flt(percentage(usage[i])) << " %)" << std::endl;
+    }
 }
 
 }
@@ -14,6 +14,7 @@
 #include "SubComponent.h"
 #include "Colors.h"
 #include "Constants.h"
+#include <fstream>
 
 namespace vamiga {
 
@@ -37,6 +38,33 @@ class DmaDebugger : public SubComponent {
     // HSYNC handler information (recorded in the EOL handler)
     isize pixel0 = 0;
 
+    /* DMA trace file. If a trace is recorded, the bus owner and bus value of
+     * each DMA slot is written to this file. The file starts with a header
+     * followed by one record per frame:
+     *
+     *   Header:  "VADT"         Magic bytes
+     *            u16            Format version
+     *            u16            Number of DMA slots per line (HPOS_CNT)
+     *
+     *   Frame:   i64            Frame number
+     *            u16            Number of recorded lines
+     *
+     *   Line:    u16            Vertical beam position
+     *            u8[HPOS_CNT]   Bus owners
+     *            u16[HPOS_CNT]  Bus values
+     *
+     * All multi-byte values are stored in little endian format.
+     */
+    std::ofstream traceFile;
+    static constexpr u16 traceVersion = 1;
+
+    // Recorded lines of the current frame (written out in the EOF handler)
+    std::vector<u8> traceBuffer;
+    isize traceLines = 0;
+
+    // Number of frames written to the trace file
+    i64 traceFrames = 0;
+
 
     //
     // Initializing
@@ -130,6 +158,32 @@ private:
 
     // Visualizes DMA usage for a certain range of DMA cycles
     void computeOverlay(Texel *ptr, isize first, isize last, BusOwner *own, u16 *val);
+
+
+    //
+    // Recording DMA traces
+    //
+
+public:
+
+    // Starts or stops recording a DMA trace
+    void startTrace(const string &path) throws;
+    void stopTrace();
+    bool isTracing() const { return traceFile.is_open(); }
+
+    // Reads a DMA trace file and prints a summary of the bus usage
+    static void analyzeTrace(const string &path, std::ostream &os) throws;
+
+private:
+
+    // Adds the current line to the trace buffer
+    void recordTraceLine();
+
+    // Writes the trace buffer to the trace file
+    void flushTrace();
+
+    // Closes the trace file (called with the emulator thread suspended)
+    void closeTrace();
 };
 
 }
@@ -23,6 +23,9 @@ Sequencer::_reset(bool hard)
 {
     RESET_SNAPSHOT_ITEMS(hard)
     
+    clearBplCache();
+    if (hard) bplCacheHits = bplCacheMisses = 0;
+
     initBplEvents();
     initDasEvents();
 }
@@ -115,6 +115,36 @@ static constexpr usize UPDATE_SIG_RECORDER  = 0b001;
 static constexpr usize UPDATE_BPL_TABLE     = 0b010;
 static constexpr usize UPDATE_DAS_TABLE     = 0b100;
 
+/* Computing the bitplane event table is a costly operation, but most lines of
+ * a frame share the same DMA layout. Hence, recently computed tables are kept
+ * in a small cache. An entry is reused if all inputs of the computation match,
+ * i.e., the initial DDF state, the recorded signals, the scroll values, and
+ * the chipset revision.
+ */
+struct BplTableCacheEntry
+{
+    // Maximum number of signals a cacheable signal recorder may contain
+    static constexpr isize maxSignals = 16;
+
+    // Indicates if this entry contains valid data
+    bool valid = false;
+
+    // Inputs
+    bool ecs;
+    bool modified;
+    i8 scrollOdd;
+    i8 scrollEven;
+    DDFState initial;
+    isize count;
+    i64 keys[maxSignals];
+    u32 signals[maxSignals];
+
+    // Outputs
+    DDFState result;
+    EventID bplEvent[HPOS_CNT];
+    u8 nextBplEvent[HPOS_CNT];
+};
+
 class Sequencer : public SubComponent
 {
     friend class Agnus;
@@ -194,6 +224,21 @@ private:
     
     // Action flags controlling the HSYNC handler
     usize hsyncActions;
+
+
+    //
+    // Event table cache
+    //
+
+private:
+
+    // Recently computed bitplane event tables
+    static constexpr isize bplCacheSize = 32;
+    BplTableCacheEntry bplCache[bplCacheSize];
+
+    // Cache statistics
+    i64 bplCacheHits = 0;
+    i64 bplCacheMisses = 0;
     
     
     //
@@ -313,6 +358,11 @@ private:
     // Processes a signal change
     template <bool ecs> void processSignal(u32 signal, DDFState &state);
 
+    // Looks up or stores the BPL event table in the event table cache
+    BplTableCacheEntry &bplCacheSlot(const SigRecorder &sr, const DDFState &state);
+    bool bplCacheMatches(const BplTableCacheEntry &entry, const SigRecorder &sr, const DDFState &state) const;
+    void clearBplCache();
+
     // Updates the jump table for the bplEvent table
     void updateBplJumpTable(i16 end = HPOS_MAX);
 
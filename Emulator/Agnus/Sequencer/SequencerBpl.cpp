@@ -10,6 +10,7 @@
 #include "config.h"
 #include "Sequencer.h"
 #include "Agnus.h"
+#include "Checksum.h"
 
 namespace vamiga {
 
@@ -55,15 +56,56 @@ Sequencer::computeBplEventTable(const SigRecorder &sr)
     // Evaluate the current state of the vertical DIW flipflop
     if (!state.bpv) { state.bprun = false; state.cnt = 0; }
     
-    // Fill the event table
-    if (sr.modified || (state.bpv && state.bmapen) || NO_SEQ_FASTPATH) {
-        computeBplEventsSlow <ecs> (sr, state);
+    // Check if the table has been computed before
+    auto &entry = bplCacheSlot(sr, state);
+
+    if (entry.valid && bplCacheMatches(entry, sr, state)) {
+
+        bplCacheHits++;
+        std::memcpy(bplEvent, entry.bplEvent, sizeof(bplEvent));
+        std::memcpy(nextBplEvent, entry.nextBplEvent, sizeof(nextBplEvent));
+        state = entry.result;
+        computeFetchUnit(state.bplcon0);
+
     } else {
-        computeBplEventsFast <ecs> (sr, state);
+
+        bplCacheMisses++;
+
+        // Remember the inputs
+        bool cacheable = sr.count() <= BplTableCacheEntry::maxSignals && !NO_SEQ_CACHE;
+        if (cacheable) {
+
+            entry.ecs = ecs;
+            entry.modified = sr.modified;
+            entry.scrollOdd = agnus.scrollOdd;
+            entry.scrollEven = agnus.scrollEven;
+            entry.initial = state;
+            entry.count = sr.count();
+            for (isize i = 0; i < sr.count(); i++) {
+                entry.keys[i] = sr.keys[i];
+                entry.signals[i] = sr.elements[i];
+            }
+        }
+
+        // Fill the event table
+        if (sr.modified || (state.bpv && state.bmapen) || NO_SEQ_FASTPATH) {
+            computeBplEventsSlow <ecs> (sr, state);
+        } else {
+            computeBplEventsFast <ecs> (sr, state);
+        }
+
+        // Update the jump table
+        updateBplJumpTable();
+
+        // Remember the outputs
+        if (cacheable) {
+
+            std::memcpy(entry.bplEvent, bplEvent, sizeof(bplEvent));
+            std::memcpy(entry.nextBplEvent, nextBplEvent, sizeof(nextBplEvent));
+            entry.result = state;
+        }
+        entry.valid = cacheable;
     }
-    
-    // Update the jump table
-    updateBplJumpTable();
 
     // Rectify the scheduled event
     agnus.scheduleBplEventForCycle(agnus.pos.h);
@@ -440,6 +482,50 @@ Sequencer::processSignal <true> (u32 signal, DDFState &state)
     }
 }
 
+BplTableCacheEntry &
+Sequencer::bplCacheSlot(const SigRecorder &sr, const DDFState &state)
+{
+    auto hash = util::fnvInit64();
+
+    hash = util::fnvIt64(hash, HI_W_LO_W(state.bplcon0, state.cnt));
+    hash = util::fnvIt64(hash, HI_W_LO_W(u8(agnus.scrollOdd), u8(agnus.scrollEven)));
+    hash = util::fnvIt64(hash, state.bpv | state.bmapen << 1 | state.shw << 2 |
+                         state.rhw << 3 | state.bphstart << 4 | state.bphstop << 5 |
+                         state.bprun << 6 | state.lastFu << 7 | state.stopreq << 8);
+
+    for (isize i = 0; i < sr.count(); i++) {
+        hash = util::fnvIt64(hash, u64(sr.keys[i]) << 32 | sr.elements[i]);
+    }
+
+    return bplCache[hash % bplCacheSize];
+}
+
+bool
+Sequencer::bplCacheMatches(const BplTableCacheEntry &entry,
+                           const SigRecorder &sr, const DDFState &state) const
+{
+    if (entry.ecs != agnus.isECS()) return false;
+    if (entry.modified != sr.modified) return false;
+    if (entry.scrollOdd != agnus.scrollOdd) return false;
+    if (entry.scrollEven != agnus.scrollEven) return false;
+    if (entry.initial != state) return false;
+    if (entry.count != sr.count()) return false;
+
+    for (isize i = 0; i < entry.count; i++) {
+
+        if (entry.keys[i] != sr.keys[i]) return false;
+        if (entry.signals[i] != sr.elements[i]) return false;
+    }
+
+    return true;
+}
+
+void
+Sequencer::clearBplCache()
+{
+    for (isize i = 0; i < bplCacheSize; i++) bplCache[i].valid = false;
+}
+
 void
 Sequencer::updateBplJumpTable(i16 end)
 {
@@ -43,6 +43,16 @@ Sequencer::_dump(Category category, std::ostream& os) const
         os << hex(ddf.bplcon0) << " (" << hex(ddfInitial.bplcon0) << ")" << std::endl;
         os << tab("CNT");
         os << dec(ddf.cnt) << " (" << dec(ddfInitial.cnt) << ")" << std::endl;
+
+        auto total = bplCacheHits + bplCacheMisses;
+        auto rate = total ? 100.0 * bplCacheHits / total : 0.0;
+        os << std::endl;
+        os << tab("Table cache hits");
+        os << dec(bplCacheHits) << std::endl;
+        os << tab("Table cache misses");
+        os << dec(bplCacheMisses) << std::endl;
+        os << tab("Hit rate");
+        os << flt(rate) << " %" << std::endl;
     }
 
     if (category == Category::Registers) {
@@ -248,6 +248,7 @@ Amiga::getConfigItem(Option option) const
         case OPT_BRIGHTNESS:
         case OPT_CONTRAST:
         case OPT_SATURATION:
+        case OPT_COLOR_PIPELINE:
             
             return denise.pixelEngine.getConfigItem(option);
             
@@ -482,6 +483,7 @@ Amiga::configure(Option option, i64 value)
         case OPT_BRIGHTNESS:
         case OPT_CONTRAST:
         case OPT_SATURATION:
+        case OPT_COLOR_PIPELINE:
             
             denise.pixelEngine.setConfigItem(option, value);
             break;
@@ -36,6 +36,7 @@ enum_long(OPT)
     OPT_BRIGHTNESS,
     OPT_CONTRAST,
     OPT_SATURATION,
+    OPT_COLOR_PIPELINE,
     
     // DMA Debugger
     OPT_DMA_DEBUG_ENABLE,
@@ -168,6 +169,7 @@ struct OptionEnum : util::Reflection<OptionEnum, Option>
             case OPT_BRIGHTNESS:            return "BRIGHTNESS";
             case OPT_CONTRAST:              return "CONTRAST";
             case OPT_SATURATION:            return "SATURATION";
+            case OPT_COLOR_PIPELINE:        return "COLOR_PIPELINE";
 
             case OPT_DMA_DEBUG_ENABLE:      return "DMA_DEBUG_ENABLE";
             case OPT_DMA_DEBUG_MODE:        return "DMA_DEBUG_MODE";
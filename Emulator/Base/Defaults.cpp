@@ -42,6 +42,7 @@ Defaults::Defaults()
     setFallback(OPT_BRIGHTNESS, 50);
     setFallback(OPT_CONTRAST, 100);
     setFallback(OPT_SATURATION, 50);
+    setFallback(OPT_COLOR_PIPELINE, false);
     setFallback(OPT_DMA_DEBUG_ENABLE, false);
     setFallback(OPT_DMA_DEBUG_MODE, DMA_DISPLAY_MODE_FG_LAYER);
     setFallback(OPT_DMA_DEBUG_OPACITY, 50);
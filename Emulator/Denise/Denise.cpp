@@ -21,8 +21,12 @@ Denise::Denise(Amiga& ref) : SubComponent(ref)
     subComponents = std::vector<AmigaComponent *> {
         
         &pixelEngine,
-        &screenRecorder
+        &screenRecorder,
+        &frameExport
     };
+
+    lineBuffers.resize(PixelEngine::jobCapacity);
+    selectLineBuffers(0);
 }
 
 void
@@ -30,10 +34,20 @@ Denise::_reset(bool hard)
 {
     RESET_SNAPSHOT_ITEMS(hard)
     
-    std::memset(bBuffer, 0, sizeof(bBuffer));
-    std::memset(iBuffer, 0, sizeof(iBuffer));
-    std::memset(mBuffer, 0, sizeof(mBuffer));
-    std::memset(zBuffer, 0, sizeof(zBuffer));
+    std::memset(bBuffer, 0, lineBufferSize * sizeof(u8));
+    std::memset(iBuffer, 0, lineBufferSize * sizeof(u8));
+    std::memset(mBuffer, 0, lineBufferSize * sizeof(u8));
+    std::memset(zBuffer, 0, lineBufferSize * sizeof(u16));
+
+    chunkCnt = 0;
+}
+
+isize
+Denise::didLoadFromBuffer(const u8 *buffer)
+{
+    // Discard the bitplane chunks of the interrupted line
+    chunkCnt = 0;
+    return 0;
 }
 
 void
@@ -187,41 +201,56 @@ Denise::updateShiftRegistersEven()
 }
 
 void
-Denise::extractSlices(u8 slices[16])
+Denise::recordChunk(Resolution mode, u8 planes, Pixel pixel, u16 mask)
 {
-    u16 mask = 0x8000;
-    for (isize i = 0; i < 16; i++, mask >>= 1) {
-        
-        slices[i] = (u8) ((!!(shiftReg[0] & mask) << 0) |
-                          (!!(shiftReg[1] & mask) << 1) |
-                          (!!(shiftReg[2] & mask) << 2) |
-                          (!!(shiftReg[3] & mask) << 3) |
-                          (!!(shiftReg[4] & mask) << 4) |
-                          (!!(shiftReg[5] & mask) << 5) );
-    }
+    // Make room if the buffer is full
+    if (chunkCnt == chunkCapacity) drawChunks();
+
+    std::memcpy(chunkData[chunkCnt], shiftReg, sizeof(shiftReg));
+    chunks[chunkCnt++] = BplChunk { pixel, mask, mode, planes };
+
+    if constexpr (NO_BPL_BATCHING) drawChunks();
 }
 
 void
-Denise::extractSlicesOdd(u8 slices[16])
+Denise::drawChunks()
 {
-    u16 mask = 0x8000;
-    for (isize i = 0; i < 16; i++, mask >>= 1) {
-        
-        slices[i] = (u8) ((!!(shiftReg[0] & mask) << 0) |
-                          (!!(shiftReg[2] & mask) << 2) |
-                          (!!(shiftReg[4] & mask) << 4) );
+    if (chunkCnt == 0) return;
+
+    // Transpose all recorded chunks in a single batch
+    alignas(32) u8 slices[chunkCapacity][16];
+    util::transpose(&chunkData[0][0], &slices[0][0], chunkCnt);
+
+    // Synthesize pixels in the order the chunks have been recorded
+    for (isize i = 0; i < chunkCnt; i++) {
+
+        auto &chunk = chunks[i];
+
+        switch (chunk.mode) {
+
+            case LORES: drawSlices <LORES> (slices[i], chunk); break;
+            case HIRES: drawSlices <HIRES> (slices[i], chunk); break;
+            case SHRES: drawSlices <SHRES> (slices[i], chunk); break;
+
+            default:
+                fatalError;
+        }
     }
+
+    chunkCnt = 0;
 }
 
-void
-Denise::extractSlicesEven(u8 slices[16])
+template <Resolution mode> void
+Denise::drawSlices(const u8 *slices, const BplChunk &chunk)
 {
-    u16 mask = 0x8000;
-    for (isize i = 0; i < 16; i++, mask >>= 1) {
-        
-        slices[i] = (u8) ((!!(shiftReg[1] & mask) << 1) |
-                          (!!(shiftReg[3] & mask) << 3) |
-                          (!!(shiftReg[5] & mask) << 5) );
+    switch (chunk.planes) {
+
+        case BPL_ODD:  drawOdd <mode> (slices, chunk.pixel, chunk.mask); break;
+        case BPL_EVEN: drawEven <mode> (slices, chunk.pixel, chunk.mask); break;
+        case BPL_BOTH: drawBoth <mode> (slices, chunk.pixel, chunk.mask); break;
+
+        default:
+            fatalError;
     }
 }
 
@@ -239,12 +268,15 @@ Denise::drawOdd(Pixel offset)
         0b010101  // 6 bitplanes
     };
     
-    u16 mask = masks[bpu()];
-    Pixel pixel = agnus.pos.pixel() + offset + 2;
+    recordChunk(mode, BPL_ODD, agnus.pos.pixel() + offset + 2, masks[bpu()]);
 
-    u8 slices[16];
-    extractSlicesOdd(slices);
-    
+    // Clear the shift registers
+    shiftReg[0] = shiftReg[2] = shiftReg[4] = 0;
+}
+
+template <Resolution mode> void
+Denise::drawOdd(const u8 *slices, Pixel pixel, u16 mask)
+{
     for (isize i = 0; i < 16; i++) {
         
         u8 index = slices[i] & mask;
@@ -254,7 +286,7 @@ Denise::drawOdd(Pixel offset)
             case LORES:
 
                 // Synthesize two lores pixels
-                assert(pixel + 1 < isizeof(bBuffer));
+                assert(pixel + 1 < lineBufferSize);
                 bBuffer[pixel] = (bBuffer[pixel] & 0b101010) | index;
                 pixel++;
                 bBuffer[pixel] = (bBuffer[pixel] & 0b101010) | index;
@@ -264,7 +296,7 @@ Denise::drawOdd(Pixel offset)
             case HIRES:
 
                 // Synthesize one hires pixel
-                assert(pixel < isizeof(bBuffer));
+                assert(pixel < lineBufferSize);
                 bBuffer[pixel] = (bBuffer[pixel] & 0b101010) | index;
                 pixel++;
                 break;
@@ -272,7 +304,7 @@ Denise::drawOdd(Pixel offset)
             case SHRES:
 
                 // Synthesize a superHires pixel
-                assert(pixel < isizeof(bBuffer));
+                assert(pixel < lineBufferSize);
                 if (i % 2 == 0) {
                     bBuffer[pixel] = u8((bBuffer[pixel] & 0b111011) | index << 2);
                 } else {
@@ -285,9 +317,6 @@ Denise::drawOdd(Pixel offset)
                 fatalError;
         }
     }
-
-    // Clear the shift registers
-    shiftReg[0] = shiftReg[2] = shiftReg[4] = 0;
 }
 
 template <Resolution mode> void
@@ -304,12 +333,15 @@ Denise::drawEven(Pixel offset)
         0b101010  // 6 bitplanes
     };
     
-    u16 mask = masks[bpu()];
-    Pixel pixel = agnus.pos.pixel() + offset + 2;
+    recordChunk(mode, BPL_EVEN, agnus.pos.pixel() + offset + 2, masks[bpu()]);
 
-    u8 slices[16];
-    extractSlicesEven(slices);
-    
+    // Clear the shift registers
+    shiftReg[1] = shiftReg[3] = shiftReg[5] = 0;
+}
+
+template <Resolution mode> void
+Denise::drawEven(const u8 *slices, Pixel pixel, u16 mask)
+{
     for (isize i = 0; i < 16; i++) {
 
         u8 index = slices[i] & mask;
@@ -319,7 +351,7 @@ Denise::drawEven(Pixel offset)
             case LORES:
 
                 // Synthesize s lores pixel
-                assert(pixel + 1 < isizeof(bBuffer));
+                assert(pixel + 1 < lineBufferSize);
                 bBuffer[pixel] = (bBuffer[pixel] & 0b010101) | index;
                 pixel++;
                 bBuffer[pixel] = (bBuffer[pixel] & 0b010101) | index;
@@ -329,7 +361,7 @@ Denise::drawEven(Pixel offset)
             case HIRES:
 
                 // Synthesize a hires pixel
-                assert(pixel < isizeof(bBuffer));
+                assert(pixel < lineBufferSize);
                 bBuffer[pixel] = (bBuffer[pixel] & 0b010101) | index;
                 pixel++;
                 break;
@@ -337,7 +369,7 @@ Denise::drawEven(Pixel offset)
             case SHRES:
 
                 // Synthesize a superHires pixel
-                assert(pixel < isizeof(bBuffer));
+                assert(pixel < lineBufferSize);
                 if (i % 2 == 0) {
                     bBuffer[pixel] = u8((bBuffer[pixel] & 0b110111) | index << 2);
                 } else {
@@ -350,9 +382,6 @@ Denise::drawEven(Pixel offset)
                 fatalError;
         }
     }
-
-    // Clear the shift registers
-    shiftReg[1] = shiftReg[3] = shiftReg[5] = 0;
 }
 
 template <Resolution mode> void
@@ -376,12 +405,15 @@ Denise::drawBoth(Pixel offset)
         0b111111  // 6 bitplanes
     };
 
-    u16 mask = masks[bpu()];
-    Pixel pixel = agnus.pos.pixel() + offset + 2;
+    recordChunk(mode, BPL_BOTH, agnus.pos.pixel() + offset + 2, masks[bpu()]);
 
-    u8 slices[16];
-    extractSlices(slices);
+    // Clear the shift registers
+    for (isize i = 0; i < 6; i++) shiftReg[i] = 0;
+}
 
+template <Resolution mode> void
+Denise::drawBoth(const u8 *slices, Pixel pixel, u16 mask)
+{
     for (isize i = 0; i < 16; i++) {
 
         u8 index = slices[i] & mask;
@@ -391,7 +423,7 @@ Denise::drawBoth(Pixel offset)
             case LORES:
 
                 // Synthesize s lores pixel
-                assert(pixel + 1 < isizeof(bBuffer));
+                assert(pixel + 1 < lineBufferSize);
                 bBuffer[pixel] = index;
                 pixel++;
                 bBuffer[pixel] = index;
@@ -401,7 +433,7 @@ Denise::drawBoth(Pixel offset)
             case HIRES:
 
                 // Synthesize a hires pixel
-                assert(pixel < isizeof(bBuffer));
+                assert(pixel < lineBufferSize);
                 bBuffer[pixel] = index;
                 pixel++;
                 break;
@@ -409,7 +441,7 @@ Denise::drawBoth(Pixel offset)
             case SHRES:
 
                 // Synthesize a superHires pixel
-                assert(pixel < isizeof(bBuffer));
+                assert(pixel < lineBufferSize);
                 if (i % 2 == 0) {
                     bBuffer[pixel] = u8(index << 2);
                 } else {
@@ -422,9 +454,6 @@ Denise::drawBoth(Pixel offset)
                 fatalError;
         }
     }
-
-    // Clear the shift registers
-    for (isize i = 0; i < 6; i++) shiftReg[i] = 0;
 }
 
 void
@@ -514,6 +543,17 @@ Denise::drawShresBoth()
     drawShresEven();
 }
 
+void
+Denise::selectLineBuffers(isize nr)
+{
+    assert(nr >= 0 && nr < isize(lineBuffers.size()));
+
+    bBuffer = lineBuffers[nr].bBuffer;
+    iBuffer = lineBuffers[nr].iBuffer;
+    mBuffer = lineBuffers[nr].mBuffer;
+    zBuffer = lineBuffers[nr].zBuffer;
+}
+
 void
 Denise::translate()
 {
@@ -522,7 +562,7 @@ Denise::translate()
     // Wipe out some bitplane data if requested
     if (config.hiddenBitplanes) {
 
-        for (isize i = 0; i < isizeof(bBuffer); i++) {
+        for (isize i = 0; i < lineBufferSize; i++) {
             bBuffer[i] &= ~config.hiddenBitplanes;
         }
     }
@@ -536,7 +576,7 @@ Denise::translate()
     bool dual = dbplf(initialBplcon0);
 
     // Add a dummy register change to ensure we draw until the line ends
-    conChanges.insert(sizeof(bBuffer), RegChange { SET_NONE, 0 });
+    conChanges.insert(lineBufferSize, RegChange { SET_NONE, 0 });
 
     // Iterate over all recorded register changes
     for (isize i = 0, end = conChanges.end(); i < end; i++) {
@@ -592,28 +632,28 @@ Denise::translateSPF(Pixel from, Pixel to, PFState &state)
      * Denise/BPLCON0/invprio0 to Denise/BPLCON0/invprio3
      */
     
-    if (!state.zpf2 && !state.ham) {
-        
-        for (Pixel i = from; i < to; i++) {
+    bool invalid = !state.zpf2 && !state.ham;
+
+    // Setup the translation tables
+    u8 index[64];
+    u16 depth[64];
+
+    for (u8 s = 0; s < 64; s++) {
 
-            u8 s = bBuffer[i];
+        if (invalid) {
 
-            assert(PixelEngine::isPaletteIndex(s));
-            iBuffer[i] = mBuffer[i] = (s & 0x10) ? (s & 0x30) : s;
-            zBuffer[i] = 0;
+            index[s] = (s & 0x10) ? (s & 0x30) : s;
+            depth[s] = 0;
+
+        } else {
+
+            // Translate the usual way
+            index[s] = s;
+            depth[s] = s ? state.zpf2 : 0;
         }
-        return;
-    }
-    
-    // Translate the usual way
-    for (Pixel i = from; i < to; i++) {
-        
-        u8 s = bBuffer[i];
-        
-        assert(PixelEngine::isPaletteIndex(s));
-        iBuffer[i] = mBuffer[i] = s;
-        zBuffer[i] = s ? state.zpf2 : 0;
     }
+
+    translate(from, to, index, depth);
 }
 
 void
@@ -635,9 +675,11 @@ Denise::translateDPF(Pixel from, Pixel to, PFState &state)
     u8 mask1 = state.zpf1 ? 0b1111 : 0b0000;
     u8 mask2 = state.zpf2 ? 0b1111 : 0b0000;
 
-    for (Pixel i = from; i < to; i++) {
+    // Setup the translation tables
+    u8 index[64];
+    u16 depth[64];
 
-        u8 s = bBuffer[i];
+    for (u8 s = 0; s < 64; s++) {
 
         // Determine color indices for both playfields
         u8 index1 = (((s & 1) >> 0) | ((s & 4) >> 1) | ((s & 16) >> 2));
@@ -649,18 +691,18 @@ Denise::translateDPF(Pixel from, Pixel to, PFState &state)
 
                 // PF1 is solid, PF2 is solid
                 if (prio) {
-                    iBuffer[i] = mBuffer[i] = (index2 | 0b1000) & mask2;
-                    zBuffer[i] = state.zpf2 | Z_DPF21;
+                    index[s] = (index2 | 0b1000) & mask2;
+                    depth[s] = state.zpf2 | Z_DPF21;
                 } else {
-                    iBuffer[i] = mBuffer[i] = index1 & mask1;
-                    zBuffer[i] = state.zpf1 | Z_DPF12;
+                    index[s] = index1 & mask1;
+                    depth[s] = state.zpf1 | Z_DPF12;
                 }
 
             } else {
 
                 // PF1 is solid, PF2 is transparent
-                iBuffer[i] = mBuffer[i] = index1 & mask1;
-                zBuffer[i] = state.zpf1 | Z_DPF1;
+                index[s] = index1 & mask1;
+                depth[s] = state.zpf1 | Z_DPF1;
             }
 
         } else {
@@ -668,17 +710,46 @@ Denise::translateDPF(Pixel from, Pixel to, PFState &state)
             if (index2) {
 
                 // PF1 is transparent, PF2 is solid
-                iBuffer[i] = mBuffer[i] = (index2 | 0b1000) & mask2;
-                zBuffer[i] = state.zpf2 | Z_DPF2;
+                index[s] = (index2 | 0b1000) & mask2;
+                depth[s] = state.zpf2 | Z_DPF2;
 
             } else {
 
                 // PF1 is transparent, PF2 is transparent
-                iBuffer[i] = mBuffer[i] = 0;
-                zBuffer[i] = Z_DPF;
+                index[s] = 0;
+                depth[s] = Z_DPF;
             }
         }
     }
+
+    translate(from, to, index, depth);
+}
+
+void
+Denise::translate(Pixel from, Pixel to, const u8 index[64], const u16 depth[64])
+{
+    if (to <= from) return;
+
+    assert(to <= lineBufferSize);
+
+    // Translate 32 pixels at once (if supported by the host CPU)
+    util::lookup64(bBuffer + from, iBuffer + from, index, to - from);
+    util::lookup64(bBuffer + from, zBuffer + from, depth, to - from);
+    std::memcpy(mBuffer + from, iBuffer + from, to - from);
+
+#ifndef NDEBUG
+
+    // Check the table contents
+    for (isize s = 0; s < 64; s++) assert(PixelEngine::isPaletteIndex(index[s]));
+
+    // Check the vectorized lookup against the scalar definition
+    for (Pixel i = from; i < to; i++) {
+
+        assert(iBuffer[i] == index[bBuffer[i] & 0x3F]);
+        assert(zBuffer[i] == depth[bBuffer[i] & 0x3F]);
+    }
+
+#endif
 }
 
 void
@@ -723,6 +794,7 @@ Denise::drawSpritePair()
     Pixel strt = 0;
     Pixel strt1 = sprhppos[sprite1] & hposMask;
     Pixel strt2 = sprhppos[sprite2] & hposMask;
+    bool active = false;
     
     // Iterate over all recorded register changes
     if (!sprChanges[pair].isEmpty()) {
@@ -732,8 +804,9 @@ Denise::drawSpritePair()
             Pixel trigger = (Pixel)sprChanges[pair].keys[i];
             RegChange &change = sprChanges[pair].elements[i];
             
-            // Draw a chunk of pixels
-            drawSpritePair <pair,R> (strt, trigger, strt1, strt2);
+            // Draw a chunk of pixels and check for collisions
+            active |= drawSpritePair <pair,R> (strt, trigger, strt1, strt2);
+            if (active) checkSpritePairCollisions<pair>(strt1, strt2);
             strt = trigger;
             
             // Apply the recorded register change
@@ -794,7 +867,12 @@ Denise::drawSpritePair()
     }
     
     // Draw until the end of the line
-    drawSpritePair <pair,R> (strt, sizeof(mBuffer) - 1, strt1, strt2);
+    active |= drawSpritePair <pair,R> (strt, lineBufferSize - 1, strt1, strt2);
+
+    /* Check for collisions. As long as none of the two sprites has been drawn
+     * in this line, there is nothing they can collide with.
+     */
+    if (active) checkSpritePairCollisions<pair>(strt1, strt2);
     
     sprChanges[pair].clear();
 }
@@ -864,19 +942,19 @@ Denise::replaySpriteRegChanges()
     sprChanges[pair].clear();
 }
 
-template <isize pair, Resolution R> void
+template <isize pair, Resolution R> bool
 Denise::drawSpritePair(Pixel hstrt, Pixel hstop, Pixel strt1, Pixel strt2)
 {
     assert(pair < 4);
     
     // Only proceeed if we are outside the VBLANK area
-    if (agnus.inVBlankArea()) return;
+    if (agnus.inVBlankArea()) return false;
     
     constexpr isize sprite1 = 2 * pair;
     constexpr isize sprite2 = 2 * pair + 1;
 
-    assert(hstrt <= isizeof(mBuffer));
-    assert(hstop <= isizeof(mBuffer));
+    assert(hstrt <= lineBufferSize);
+    assert(hstop <= lineBufferSize);
 
     bool armed1 = GET_BIT(armed, sprite1);
     bool armed2 = GET_BIT(armed, sprite2);
@@ -884,6 +962,9 @@ Denise::drawSpritePair(Pixel hstrt, Pixel hstop, Pixel strt1, Pixel strt2)
     bool attached = GET_BIT(sprctl[sprite2], 7);
     Pixel offset = R == SHRES ? 1 : 2;
 
+    // Indicates whether any of the two sprites has been shifted out
+    bool active = false;
+
     for (Pixel hpos = hstrt; hpos < hstop; hpos += offset) {
 
         if (hpos == strt1 && armed1) {
@@ -897,8 +978,29 @@ Denise::drawSpritePair(Pixel hstrt, Pixel hstop, Pixel strt1, Pixel strt2)
             ssrb[sprite2] = sprdatb[sprite2];
         }
 
-        if (ssra[sprite1] | ssrb[sprite1] | ssra[sprite2] | ssrb[sprite2]) {
-            
+        if (!(ssra[sprite1] | ssrb[sprite1] | ssra[sprite2] | ssrb[sprite2])) {
+
+            if constexpr (NO_SPR_FASTPATH) continue;
+
+            /* The shift registers are empty. Hence, nothing happens until one
+             * of them gets reloaded. We fast-forward to this position.
+             */
+            Pixel next = hstop;
+            if (armed1 && strt1 > hpos && (strt1 - hpos) % offset == 0) {
+                next = std::min(next, strt1);
+            }
+            if (armed2 && strt2 > hpos && (strt2 - hpos) % offset == 0) {
+                next = std::min(next, strt2);
+            }
+            if (next == hstop) break;
+
+            hpos = next - offset;
+            continue;
+        }
+
+        active = true;
+
+        {
             if (hpos >= spriteClipBegin && hpos < spriteClipEnd) {
 
                 if (attached) {
@@ -919,8 +1021,14 @@ Denise::drawSpritePair(Pixel hstrt, Pixel hstop, Pixel strt1, Pixel strt2)
         }
     }
 
+    return active;
+}
+
+template <isize pair> void
+Denise::checkSpritePairCollisions(Pixel strt1, Pixel strt2)
+{
     // Perform collision checks (if enabled)
-    if (config.clxSprSpr) {
+    if (config.clxSprSpr && (wasArmed & ~(0b11 << (2 * pair)))) {
         
         checkS2SCollisions<2 * pair>(strt1, strt1 + 31);
         checkS2SCollisions<2 * pair + 1>(strt2, strt2 + 31);
@@ -1065,6 +1173,9 @@ Denise::checkS2SCollisions(Pixel start, Pixel end)
     // For odd sprites, only proceed if collision detection is enabled
     if constexpr (IS_ODD(x)) if (!GET_BIT(clxcon, 12 + (x/2))) return;
 
+    // Quick-exit if all collision bits are already set
+    if ((clxdat & 0x7E00) == 0x7E00) return;
+
     // Set up the sprite comparison masks
     u16 comp01 = Z_SP0 | (GET_BIT(clxcon, 12) ? Z_SP1 : 0);
     u16 comp23 = Z_SP2 | (GET_BIT(clxcon, 13) ? Z_SP3 : 0);
@@ -1107,7 +1218,11 @@ Denise::checkS2PCollisions(Pixel start, Pixel end)
 {
     // For the odd sprites, only proceed if collision detection is enabled
     if constexpr (IS_ODD(x)) if (!ensp<x>()) return;
-    
+
+    // Quick-exit if both collision bits are already set
+    constexpr u16 bits = (1 << (5 + x / 2)) | (1 << (1 + x / 2));
+    if ((clxdat & bits) == bits) return;
+
     u8 enabled1 = enbp1();
     u8 enabled2 = enbp2();
     u8 compare1 = mvbp1() & enabled1;
@@ -1157,21 +1272,13 @@ Denise::checkP2PCollisions()
     u8 compare1 = mvbp1() & enabled1;
     u8 compare2 = mvbp2() & enabled2;
 
-    // Check all pixels one by one
-    for (isize pos = 0; pos < HPIXELS; pos++) {
-
-        u16 b = bBuffer[pos];
-
-        // Check if there is a hit with playfield 1
-        if ((b & enabled1) != compare1) continue;
-
-        // Check if there is a hit with playfield 2
-        if ((b & enabled2) != compare2) continue;
+    /* Since both enable masks are disjoint, a pixel hits both playfields if
+     * and only if it matches the combined pattern.
+     */
+    if (util::findMasked(bBuffer, HPIXELS, enabled1 | enabled2, compare1 | compare2) >= 0) {
 
         // Set collision bit
         SET_BIT(clxdat, 0);
-        
-        return;
     }
 }
 
@@ -1193,6 +1300,9 @@ Denise::hsyncHandler(isize vpos)
     // Finish the current line
     //
 
+    // Synthesize all pending bitplane pixels
+    drawChunks();
+
     // Check if we are below the VBLANK area
     if (vpos >= 26) {
 
@@ -1231,10 +1341,10 @@ Denise::hsyncHandler(isize vpos)
     assert(sprChanges[3].isEmpty());
 
     // Clear the last pixel if this line was a short line
-    if (agnus.pos.hLatched == HPOS_CNT_PAL) pixelEngine.getWorkingBuffer().clear(vpos, HPOS_MAX);
+    if (agnus.pos.hLatched == HPOS_CNT_PAL) pixelEngine.clearLastPixel(vpos);
 
     // Clear the bBuffer
-    std::memset(bBuffer, 0, sizeof(bBuffer));
+    std::memset(bBuffer, 0, lineBufferSize);
 
     // Remember whether sprites were armed in this line
     wasArmed = armed;
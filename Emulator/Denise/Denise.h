@@ -15,6 +15,7 @@
 #include "DeniseDebugger.h"
 #include "Memory.h"
 #include "PixelEngine.h"
+#include "FrameExport.h"
 #include "Reflection.h"
 #include "Recorder.h"
 
@@ -46,6 +47,9 @@ public:
     // A screen recorder for creating video streams
     Recorder screenRecorder = Recorder(amiga);
 
+    // Publishes video and audio data in shared memory
+    FrameExport frameExport = FrameExport(amiga);
+
     
     //
     // Counters
@@ -138,7 +142,7 @@ public:
      * written to. This is emulated in function fillShiftRegister().
      *
      * Note: The upper two array elements are dummy elements. We need them in
-     * order to pass the array as parameter to function transposeSSE().
+     * order to record the array as a matrix for util::transpose().
      */
     alignas(16) u16 shiftReg[8];
 
@@ -146,6 +150,21 @@ public:
     bool armedOdd;
     bool armedEven;
 
+    /* Bitplane data waiting to be drawn. The drawing routines don't
+     * synthesize pixels right away. They record the shift register contents
+     * together with the target position and the bitplane mask instead. All
+     * recorded chunks are transposed in a single batch by drawChunks() which
+     * is called at the end of each rasterline.
+     */
+    typedef struct { Pixel pixel; u16 mask; Resolution mode; u8 planes; } BplChunk;
+    static constexpr u8 BPL_ODD = 1;
+    static constexpr u8 BPL_EVEN = 2;
+    static constexpr u8 BPL_BOTH = 3;
+    static constexpr isize chunkCapacity = 64;
+    alignas(32) u16 chunkData[chunkCapacity][8];
+    BplChunk chunks[chunkCapacity];
+    isize chunkCnt = 0;
+
     
     //
     // Register change management
@@ -264,10 +283,27 @@ public:
      *  SPx : Set if the pixel is solid in sprite x.
      *  _x_ : Playfield priority derived from the current value in BPLCON2.
      */
-    u8 bBuffer[HPIXELS + (4 * 16) + 8];
-    u8 iBuffer[HPIXELS + (4 * 16) + 8];
-    u8 mBuffer[HPIXELS + (4 * 16) + 8];
-    u16 zBuffer[HPIXELS + (4 * 16) + 8];
+    static constexpr isize lineBufferSize = HPIXELS + (4 * 16) + 8;
+
+    u8 *bBuffer;
+    u8 *iBuffer;
+    u8 *mBuffer;
+    u16 *zBuffer;
+
+    /* Storage for the four buffers. While the colorization pipeline is
+     * running, the worker thread reads the pixel data of a line directly from
+     * the set of buffers it has been drawn into. In the meantime, Denise
+     * draws the next lines into other sets. Without the pipeline, Denise
+     * sticks to a single set.
+     */
+    struct LineBuffers {
+
+        u8 bBuffer[lineBufferSize];
+        u8 iBuffer[lineBufferSize];
+        u8 mBuffer[lineBufferSize];
+        u16 zBuffer[lineBufferSize];
+    };
+    std::vector<LineBuffers> lineBuffers;
 
     static constexpr u16 Z_0   = 0b10000000'00000000;
     static constexpr u16 Z_SP0 = 0b01000000'00000000;
@@ -409,6 +445,7 @@ private:
     u64 _checksum() override { COMPUTE_SNAPSHOT_CHECKSUM }
     isize _load(const u8 *buffer) override { LOAD_SNAPSHOT_ITEMS }
     isize _save(u8 *buffer) override { SAVE_SNAPSHOT_ITEMS }
+    isize didLoadFromBuffer(const u8 *buffer) override;
     
     
     //
@@ -453,10 +490,11 @@ public:
     void updateShiftRegistersOdd();
     void updateShiftRegistersEven();
 
-    // Extracts a bit slice from the shift registers
-    void extractSlices(u8 slices[16]);
-    void extractSlicesOdd(u8 slices[16]);
-    void extractSlicesEven(u8 slices[16]);
+    // Records the contents of the shift registers for being drawn later
+    void recordChunk(Resolution mode, u8 planes, Pixel pixel, u16 mask);
+
+    // Synthesizes the pixels of all recorded chunks
+    void drawChunks();
 
     
     //
@@ -476,6 +514,9 @@ public:
     void drawShresEven();
     void drawShresBoth();
 
+    // Lets all drawing routines write into another set of line buffers
+    void selectLineBuffers(isize nr);
+
 private:
     
     // Core drawing routines
@@ -483,6 +524,12 @@ private:
     template <Resolution mode> void drawEven(Pixel offset);
     template <Resolution mode> void drawBoth(Pixel offset);
 
+    // Called by drawChunks() to synthesize the pixels of a single chunk
+    template <Resolution mode> void drawSlices(const u8 *slices, const BplChunk &chunk);
+    template <Resolution mode> void drawOdd(const u8 *slices, Pixel pixel, u16 mask);
+    template <Resolution mode> void drawEven(const u8 *slices, Pixel pixel, u16 mask);
+    template <Resolution mode> void drawBoth(const u8 *slices, Pixel pixel, u16 mask);
+
     // Data type used by the translation functions
     typedef struct { u16 zpf1; u16 zpf2; bool prio; bool ham; } PFState;
 
@@ -498,6 +545,11 @@ private:
     // Called by translateDPF(...)
     template <bool prio> void translateDPF(Pixel from, Pixel to, PFState &state);
 
+    /* Translates a chunk of bitplane data. Each bBuffer value is translated
+     * into a color index and a depth value via the provided lookup tables.
+     */
+    void translate(Pixel from, Pixel to, const u8 index[64], const u16 depth[64]);
+
     
     //
     // Drawing the border
@@ -536,7 +588,9 @@ private:
 
     // Draws an sprite pair. Called by drawSprites()
     template <isize pair, Resolution R> void drawSpritePair();
-    template <isize pair, Resolution R> void drawSpritePair(Pixel hstrt, Pixel hstop,
+
+    // Draws a chunk of a sprite pair. Returns true if a pixel has been shifted out
+    template <isize pair, Resolution R> bool drawSpritePair(Pixel hstrt, Pixel hstop,
                                                             Pixel strt1, Pixel strt2);
     
     // Replays all recorded sprite register changes
@@ -553,6 +607,9 @@ private:
 
 private:
 
+    // Performs all enabled collision checks for a sprite pair
+    template <isize pair> void checkSpritePairCollisions(Pixel strt1, Pixel strt2);
+
     // Checks for sprite-sprite collisions in the current rasterline
     template <int x> void checkS2SCollisions(Pixel start, Pixel end);
 
@@ -28,6 +28,7 @@ FrameBuffer::clear()
             ptr[col] = ((row >> 2) & 1) == ((col >> 3) & 1) ? cb1 : cb2;
         }
     }
+    dirty.set();
 }
 
 void
@@ -38,6 +39,7 @@ FrameBuffer::clear(isize row)
     for (isize col = 0; col < HPIXELS; col++) {
         ptr[col] = ((row >> 2) & 1) == ((col >> 3) & 1) ? cb1 : cb2;
     }
+    dirty.set(row);
 }
 
 void
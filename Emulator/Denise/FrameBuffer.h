@@ -13,6 +13,7 @@
 #include "Buffer.h"
 #include "Constants.h"
 #include "Colors.h"
+#include <bitset>
 
 using util::Buffer;
 
@@ -42,6 +43,9 @@ struct FrameBuffer {
     i64 nr;
     bool longFrame;
 
+    // Lines that differ from the frame the consumer has picked up before
+    std::bitset<VPIXELS> dirty;
+
     FrameBuffer();
 
     // Initializes (a portion of) the frame buffer with a checkerboard pattern
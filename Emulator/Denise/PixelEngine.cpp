@@ -13,11 +13,40 @@
 #include "Colors.h"
 #include "Denise.h"
 #include "DmaDebugger.h"
+#include "SSEUtils.h"
+#include "Checksum.h"
 
 #include <fstream>
 
 namespace vamiga {
 
+// Folds a value into a hash value (uses the SplitMix64 finalizer)
+static u64
+hashIt(u64 hash, u64 value)
+{
+    u64 x = hash ^ value;
+
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EB;
+    return x ^ (x >> 31);
+}
+
+// Folds a block of 8-byte words into a hash value
+static u64
+hashWords(u64 hash, const void *addr, isize size)
+{
+    assert(size % 8 == 0);
+
+    auto *ptr = (const u8 *)addr;
+    for (isize i = 0; i < size; i += 8) {
+
+        u64 word;
+        std::memcpy(&word, ptr + i, sizeof(word));
+        hash = hashIt(hash, word);
+    }
+    return hash;
+}
+
 PixelEngine::PixelEngine(Amiga& ref) : SubComponent(ref)
 {
     // Create random background noise pattern
@@ -27,11 +56,24 @@ PixelEngine::PixelEngine(Amiga& ref) : SubComponent(ref)
     }
 }
 
+PixelEngine::~PixelEngine()
+{
+    stopPipeline();
+}
+
 void
 PixelEngine::clearAll()
 {
-    emuTexture[0].clear();
-    emuTexture[1].clear();
+    flushPipeline();
+
+    for (auto &texture : emuTexture) texture.clear();
+    invalidateLines();
+}
+
+void
+PixelEngine::invalidateLines()
+{
+    std::memset(lineHash, 0, sizeof(lineHash));
 }
 
 void
@@ -49,6 +91,20 @@ PixelEngine::_dump(Category category, std::ostream& os) const
         os << dec(config.contrast) << std::endl;
         os << tab("Saturation");
         os << dec(config.saturation) << std::endl;
+        os << tab("Pipeline");
+        os << bol(config.pipeline) << std::endl;
+    }
+
+    if (category == Category::Debug) {
+
+        os << tab("Colorized lines");
+        os << dec(colorizedLines) << std::endl;
+        os << tab("Skipped lines");
+        os << dec(skippedLines) << std::endl;
+        os << tab("Worker thread");
+        os << bol(worker.joinable()) << std::endl;
+        os << tab("Pending lines");
+        os << dec(isize(jobHead - jobTail)) << std::endl;
     }
 }
 
@@ -73,13 +129,13 @@ PixelEngine::_reset(bool hard)
     
     if (hard) {
         
-        emuTexture[0].longFrame = true;
-        emuTexture[1].longFrame = true;
-        emuTexture[0].nr = 0;
-        emuTexture[1].nr = 0;
+        for (auto &texture : emuTexture) {
+
+            texture.longFrame = true;
+            texture.nr = 0;
+        }
     }
 
-    activeBuffer = 0;
     updateRGBA();
 }
 
@@ -107,7 +163,8 @@ PixelEngine::resetConfig()
         OPT_PALETTE,
         OPT_BRIGHTNESS,
         OPT_CONTRAST,
-        OPT_SATURATION
+        OPT_SATURATION,
+        OPT_COLOR_PIPELINE
     };
 
     for (auto &option : options) {
@@ -124,6 +181,7 @@ PixelEngine::getConfigItem(Option option) const
         case OPT_BRIGHTNESS:  return config.brightness;
         case OPT_CONTRAST:    return config.contrast;
         case OPT_SATURATION:  return config.saturation;
+        case OPT_COLOR_PIPELINE: return config.pipeline;
 
         default:
             fatalError;
@@ -175,6 +233,12 @@ PixelEngine::setConfigItem(Option option, i64 value)
             updateRGBA();
             return;
 
+        case OPT_COLOR_PIPELINE:
+
+            config.pipeline = (bool)value;
+            config.pipeline ? startPipeline() : stopPipeline();
+            return;
+
         default:
             fatalError;
     }
@@ -199,6 +263,12 @@ PixelEngine::setColor(isize reg, u16 value)
 void
 PixelEngine::updateRGBA()
 {
+    // Make sure the worker thread doesn't use the old colors
+    flushPipeline();
+
+    // All lines need to be recomputed with the new colors
+    invalidateLines();
+
     // Iterate through all 4096 colors
     for (u16 col = 0x000; col <= 0xFFF; col++) {
 
@@ -297,7 +367,7 @@ PixelEngine::adjustRGB(u8 &r, u8 &g, u8 &b)
 const FrameBuffer &
 PixelEngine::getStableBuffer()
 {
-    return emuTexture[!activeBuffer];
+    return emuTexture[stableBuffer];
 }
 
 FrameBuffer &
@@ -324,12 +394,65 @@ PixelEngine::stablePtr(isize row, isize col)
     return getStableBuffer().pixels.ptr + row * HPIXELS + col;
 }
 
+const FrameBuffer &
+PixelEngine::acquireStableBuffer()
+{
+    // Pick up the pending buffer if it contains a new frame
+    if (pendingBuffer.load(std::memory_order_acquire) & freshFrame) {
+
+        auto prev = pendingBuffer.exchange(u8(consumerBuffer), std::memory_order_acq_rel);
+        consumerBuffer = prev & ~freshFrame;
+    }
+
+    return emuTexture[consumerBuffer];
+}
+
 void
 PixelEngine::swapBuffers()
 {
-    activeBuffer = !activeBuffer;
+    // Wait until the working buffer is complete
+    flushPipeline();
+
+    /* If the consumer hasn't picked up the pending frame yet, it will skip
+     * it. Hence, the lines that changed in the skipped frame are reported as
+     * dirty in the new one, too.
+     */
+    if (auto pending = pendingBuffer.load(std::memory_order_acquire); pending & freshFrame) {
+        emuTexture[activeBuffer].dirty |= emuTexture[pending & ~freshFrame].dirty;
+    }
+
+    // Publish the working buffer and continue with the pending buffer
+    auto prev = pendingBuffer.exchange(u8(activeBuffer | freshFrame), std::memory_order_acq_rel);
+    stableBuffer = activeBuffer;
+    activeBuffer = prev & ~freshFrame;
+
     emuTexture[activeBuffer].nr = agnus.pos.frame;
     emuTexture[activeBuffer].longFrame = agnus.pos.lof;
+
+    // Lines are marked dirty once they have been colorized
+    if (canSkipLines()) {
+        emuTexture[activeBuffer].dirty.reset();
+    } else {
+        emuTexture[activeBuffer].dirty.set();
+    }
+
+    // Inform waiting threads
+    {
+        std::lock_guard<std::mutex> lock(frameMutex);
+        frameSeq++;
+    }
+    frameReady.notify_all();
+}
+
+i64
+PixelEngine::waitForFrame(i64 seq, util::Time timeout)
+{
+    auto now = std::chrono::system_clock::now();
+    auto delay = std::chrono::nanoseconds(timeout.asNanoseconds());
+
+    std::unique_lock<std::mutex> lock(frameMutex);
+    frameReady.wait_until(lock, now + delay, [&]{ return frameSeq > seq; });
+    return frameSeq;
 }
 
 Texel *
@@ -389,13 +512,266 @@ PixelEngine::applyRegisterChange(const RegChange &change)
     }
 }
 
+void
+PixelEngine::startPipeline()
+{
+    if (worker.joinable()) return;
+
+    debug(RUN_DEBUG, "Starting the colorization pipeline\n");
+
+    // jobHead is not reset, because it selects Denise's current line buffers
+    jobs.resize(jobCapacity);
+
+    workerRunning = true;
+    worker = std::thread(&PixelEngine::workerMain, this);
+}
+
+void
+PixelEngine::stopPipeline()
+{
+    if (!worker.joinable()) return;
+
+    debug(RUN_DEBUG, "Stopping the colorization pipeline\n");
+
+    flushPipeline();
+
+    workerRunning = false;
+    workerWakeup.wakeUp();
+    worker.join();
+}
+
+void
+PixelEngine::flushPipeline()
+{
+    publishJob();
+    workerWakeup.wakeUp();
+
+    while (jobTail.load(std::memory_order_acquire) != jobHead) {
+        jobDone.waitForWakeUp(util::Time(1000000));
+    }
+}
+
+void
+PixelEngine::clearLastPixel(isize line)
+{
+    if (jobStaged && jobs[jobHead % jobCapacity].line == line) {
+        jobs[jobHead % jobCapacity].clearLastPixel = true;
+    } else {
+        getWorkingBuffer().clear(line, HPOS_MAX);
+    }
+}
+
+void
+PixelEngine::setHiresMarker(isize line, bool value)
+{
+    if (jobStaged && jobs[jobHead % jobCapacity].line == line) {
+        jobs[jobHead % jobCapacity].hiresMarker = value;
+    } else {
+        REPLACE_BIT(*workingPtr(line), 28, value);
+    }
+}
+
+bool
+PixelEngine::isPipelined() const
+{
+    // The texture must not be modified after colorization
+    return worker.joinable() && !hasOverlays();
+}
+
+void
+PixelEngine::stageJob(isize line)
+{
+    assert(!jobStaged);
+
+    /* Wait until the worker thread has released the line buffers Denise is
+     * going to draw the next line into
+     */
+    auto next = jobHead + 1;
+    while (next - jobTail.load(std::memory_order_acquire) >= jobCapacity) {
+        jobDone.waitForWakeUp(util::Time(1000000));
+    }
+
+    auto &job = jobs[jobHead % jobCapacity];
+
+    job.frame = &getWorkingBuffer();
+    job.line = line;
+    job.dst = workingPtr(line);
+
+    // Save the color state as it is at the beginning of the line
+    std::memcpy(job.color, color, sizeof(color));
+    std::memcpy(job.palette, palette, sizeof(palette));
+    job.hamMode = hamMode;
+    job.shresMode = shresMode;
+
+    // Take over the pixel data and let Denise draw into the next buffer set
+    job.bBuffer = denise.bBuffer;
+    job.iBuffer = denise.iBuffer;
+    job.mBuffer = denise.mBuffer;
+    job.zBuffer = denise.zBuffer;
+    denise.selectLineBuffers(next % jobCapacity);
+
+    // Save all register changes and apply them to the emulator state
+    job.changeCnt = colChanges.end();
+    for (isize i = 0; i < job.changeCnt; i++) {
+
+        job.keys[i] = colChanges.keys[i];
+        job.changes[i] = colChanges.elements[i];
+        applyRegisterChange(colChanges.elements[i]);
+    }
+    colChanges.clear();
+
+    job.clearLastPixel = false;
+    job.hiresMarker = false;
+
+    jobStaged = true;
+}
+
+void
+PixelEngine::publishJob()
+{
+    if (!jobStaged) return;
+
+    jobHead.store(jobHead + 1, std::memory_order_release);
+    jobStaged = false;
+
+    // Wake up the worker thread once a couple of lines have piled up
+    if (jobHead - jobTail.load(std::memory_order_relaxed) >= jobBatch) {
+        workerWakeup.wakeUp();
+    }
+}
+
+void
+PixelEngine::workerMain()
+{
+    while (workerRunning) {
+
+        auto tail = jobTail.load(std::memory_order_relaxed);
+
+        // Wait for more work if all lines have been processed
+        if (tail == jobHead.load(std::memory_order_acquire)) {
+
+            workerWakeup.waitForWakeUp(util::Time(1000000));
+            continue;
+        }
+
+        colorize(jobs[tail % jobCapacity]);
+        jobTail.store(tail + 1, std::memory_order_release);
+        jobDone.wakeUp();
+    }
+}
+
+bool
+PixelEngine::hasOverlays() const
+{
+    return dmaDebugger.getConfig().enabled || denise.getConfig().hiddenLayers;
+}
+
+bool
+PixelEngine::canSkipLines() const
+{
+    if constexpr (NO_DIRTY_LINES) return false;
+
+    // Skipping is not possible if the texture is modified after colorization
+    return !hasOverlays();
+}
+
+u64
+PixelEngine::computeLineHash() const
+{
+    auto hash = util::fnvInit64();
+    bool ham = hamMode;
+    bool shres = shresMode;
+
+    // Take care of the color registers as they are at the beginning of the line
+    for (isize i = 0; i < 32; i++) hash = hashIt(hash, color[i].rawValue());
+    hash = hashIt(hash, u64(ham) << 1 | u64(shres));
+
+    // Take care of all register changes in this line
+    for (isize i = 0, end = colChanges.end(); i < end; i++) {
+
+        auto &change = colChanges.elements[i];
+        hash = hashIt(hash, colChanges.keys[i]);
+        hash = hashIt(hash, u64(change.addr) << 16 | change.value);
+
+        if (change.addr == 0x100) {
+
+            ham |= Denise::ham(change.value);
+            shres |= Denise::shres(change.value);
+        }
+    }
+
+    // Short lines get their last pixel cleared
+    hash = hashIt(hash, agnus.pos.hLatched);
+
+    // Take care of the pixel data
+    hash = hashWords(hash, denise.mBuffer, HPIXELS);
+    if (ham) {
+        hash = hashWords(hash, denise.bBuffer, HPIXELS);
+        hash = hashWords(hash, denise.iBuffer, HPIXELS);
+    }
+    if (ham || (shres && sizeof(Texel) == 8)) {
+
+        // In HAM mode, the z buffer tells sprite pixels apart from playfield
+        // pixels with the same mBuffer value
+        hash = hashWords(hash, denise.zBuffer, HPIXELS * sizeof(u16));
+    }
+
+    // Reserve 0 for invalid lines
+    return hash ? hash : 1;
+}
+
 void
 PixelEngine::colorize(isize line)
 {
+    auto &frame = getWorkingBuffer();
+
+    // Hand the previous line over to the worker thread
+    publishJob();
+
+    if (canSkipLines()) {
+
+        auto hash = computeLineHash();
+        auto cached = lineHash[activeBuffer][line];
+
+        frame.dirty[line] = hash != lineHash[stableBuffer][line];
+        lineHash[activeBuffer][line] = hash;
+
+        // Skip the line if the working buffer already contains it
+        if (hash == cached) {
+
+            // Apply all color register changes that happened in this line
+            for (isize i = 0, end = colChanges.end(); i < end; i++) {
+                applyRegisterChange(colChanges.elements[i]);
+            }
+            colChanges.clear();
+
+            skippedLines++;
+            return;
+        }
+
+    } else {
+
+        frame.dirty[line] = true;
+        lineHash[activeBuffer][line] = 0;
+    }
+    colorizedLines++;
+
+    // Let the worker thread colorize the line if the pipeline is running
+    if (isPipelined()) { stageJob(line); return; }
+
+    // Make sure the worker thread doesn't interfere with the overlays
+    flushPipeline();
+
     // Jump to the first pixel in the specified line in the active frame buffer
     auto *dst = workingPtr(line);
     Pixel pixel = 0;
 
+    // Get the pixel data from Denise
+    auto *bbuf = denise.bBuffer;
+    auto *ibuf = denise.iBuffer;
+    auto *mbuf = denise.mBuffer;
+    auto *zbuf = denise.zBuffer;
+
     // Initialize the HAM mode hold register with the current background color
     AmigaColor hold = color[0];
 
@@ -410,11 +786,11 @@ PixelEngine::colorize(isize line)
 
         // Colorize a chunk of pixels
         if (shresMode) {
-            colorizeSHRES(dst, pixel, trigger);
+            colorizeSHRES(dst, mbuf, zbuf, palette, pixel, trigger);
         } else if (hamMode) {
-            colorizeHAM(dst, pixel, trigger, hold);
+            colorizeHAM(dst, bbuf, ibuf, mbuf, zbuf, palette, color, pixel, trigger, hold);
         } else {
-            colorize(dst, pixel, trigger);
+            colorize(dst, mbuf, palette, pixel, trigger);
         }
         pixel = trigger;
 
@@ -432,27 +808,77 @@ PixelEngine::colorize(isize line)
 }
 
 void
-PixelEngine::colorize(Texel *dst, Pixel from, Pixel to)
+PixelEngine::colorize(ColorJob &job) const
 {
-    u8 *mbuf = denise.mBuffer;
+    Pixel pixel = 0;
 
-    for (Pixel i = from; i < to; i++) {
-        dst[i] = palette[mbuf[i]];
+    // Initialize the HAM mode hold register with the current background color
+    AmigaColor hold = job.color[0];
+
+    // Iterate over all recorded register changes
+    for (isize i = 0; i <= job.changeCnt; i++) {
+
+        // Draw until the line ends after the last register change
+        Pixel trigger = i < job.changeCnt ? (Pixel)job.keys[i] : HPIXELS;
+
+        // Colorize a chunk of pixels
+        if (job.shresMode) {
+            colorizeSHRES(job.dst, job.mBuffer, job.zBuffer, job.palette, pixel, trigger);
+        } else if (job.hamMode) {
+            colorizeHAM(job.dst, job.bBuffer, job.iBuffer, job.mBuffer, job.zBuffer,
+                        job.palette, job.color, pixel, trigger, hold);
+        } else {
+            colorize(job.dst, job.mBuffer, job.palette, pixel, trigger);
+        }
+        pixel = trigger;
+
+        if (i == job.changeCnt) break;
+
+        // Perform the register change on the local color state
+        auto &change = job.changes[i];
+
+        if (change.addr == 0x100) {
+
+            job.hamMode = Denise::ham(change.value);
+            job.shresMode = Denise::shres(change.value);
+
+        } else if (change.addr) {
+
+            auto nr = (change.addr - 0x180) >> 1;
+            assert(nr < 32);
+
+            AmigaColor newColor(change.value & 0xFFF);
+            job.color[nr] = newColor;
+            job.palette[nr] = colorSpace[change.value & 0xFFF];
+            job.palette[nr + 32] = colorSpace[newColor.ehb().rawValue()];
+        }
     }
+
+    // Wipe out the HBLANK area
+    auto start = agnus.pos.pixel(HBLANK_MIN);
+    auto stop  = agnus.pos.pixel(HBLANK_MAX);
+    for (pixel = start; pixel <= stop; pixel++) job.dst[pixel] = FrameBuffer::hblank;
+
+    // Perform post-processing
+    if (job.clearLastPixel) job.frame->clear(job.line, HPOS_MAX);
+    REPLACE_BIT(job.dst[0], 28, job.hiresMarker);
 }
 
 void
-PixelEngine::colorizeSHRES(Texel *dst, Pixel from, Pixel to)
+PixelEngine::colorize(Texel *dst, const u8 *mbuf,
+                      const Texel *pal, Pixel from, Pixel to) const
 {
-    auto *mbuf = denise.mBuffer;
-    auto *zbuf = denise.zBuffer;
+    if (to > from) util::lookup(mbuf + from, dst + from, pal, to - from);
+}
 
+void
+PixelEngine::colorizeSHRES(Texel *dst, const u8 *mbuf, const u16 *zbuf,
+                           const Texel *pal, Pixel from, Pixel to) const
+{
     if constexpr (sizeof(Texel) == 4) {
 
         // Output two super-hires pixels as a single texel
-        for (Pixel i = from; i < to; i++) {
-            dst[i] = palette[mbuf[i]];
-        }
+        if (to > from) util::lookup(mbuf + from, dst + from, pal, to - from);
 
     } else {
 
@@ -464,24 +890,22 @@ PixelEngine::colorizeSHRES(Texel *dst, Pixel from, Pixel to)
             if (Denise::isSpritePixel(zbuf[i])) {
 
                 p[0] =
-                p[1] = u32(palette[mbuf[i]]);
+                p[1] = u32(pal[mbuf[i]]);
 
             } else {
 
-                p[0] = u32(palette[mbuf[i] >> 2]);
-                p[1] = u32(palette[mbuf[i] & 3]);
+                p[0] = u32(pal[mbuf[i] >> 2]);
+                p[1] = u32(pal[mbuf[i] & 3]);
             }
         }
     }
 }
 
 void
-PixelEngine::colorizeHAM(Texel *dst, Pixel from, Pixel to, AmigaColor& ham)
+PixelEngine::colorizeHAM(Texel *dst, const u8 *bbuf, const u8 *ibuf, const u8 *mbuf,
+                         const u16 *zbuf, const Texel *pal, const AmigaColor *col,
+                         Pixel from, Pixel to, AmigaColor& ham) const
 {
-    u8 *bbuf = denise.bBuffer;
-    u8 *ibuf = denise.iBuffer;
-    u8 *mbuf = denise.mBuffer;
-
     for (Pixel i = from; i < to; i++) {
 
         u8 index = ibuf[i];
@@ -491,7 +915,7 @@ PixelEngine::colorizeHAM(Texel *dst, Pixel from, Pixel to, AmigaColor& ham)
 
             case 0b00: // Get color from register
 
-                ham = color[index];
+                ham = col[index];
                 break;
 
             case 0b01: // Modify blue
@@ -514,8 +938,8 @@ PixelEngine::colorizeHAM(Texel *dst, Pixel from, Pixel to, AmigaColor& ham)
         }
 
         // Synthesize pixel
-        if (denise.spritePixelIsVisible(i)) {
-            dst[i] = palette[mbuf[i]];
+        if (Denise::isSpritePixel(zbuf[i])) {
+            dst[i] = pal[mbuf[i]];
         } else {
             dst[i] = colorSpace[ham.rawValue()];
         }
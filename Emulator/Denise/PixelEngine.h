@@ -14,6 +14,11 @@
 #include "ChangeRecorder.h"
 #include "Constants.h"
 #include "FrameBuffer.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace vamiga {
 
@@ -32,19 +37,37 @@ public:
 
 private:
 
-    /* The emulator utilizes double-buffering for the computed textures.
-     * At any time, one of the two buffers is the "working buffer". The other
-     * one is the "stable buffer". All drawing functions write to the working
-     * buffer and the GPU reads from the stable buffer. Once a frame has
-     * been completed, the working buffer and the stable buffer are swapped.
+    /* The emulator utilizes triple-buffering for the computed textures.
+     * At any time, one of the three buffers is the "working buffer" which
+     * is written to by all drawing functions. Another buffer is owned by the
+     * consumer (usually the GPU) and the third one holds the latest frame
+     * that hasn't been picked up yet. Buffers are exchanged by atomic
+     * operations. Hence, the emulator never waits for the consumer and the
+     * consumer always gets the most recently completed frame.
      */
-    FrameBuffer emuTexture[2];
+    FrameBuffer emuTexture[3];
 
-    // The currently active buffer
+    // The buffer the emulator is drawing into
     isize activeBuffer = 0;
 
-    // Mutex for synchronizing access to the stable buffer
-    util::Mutex bufferMutex;
+    // The most recently completed buffer
+    isize stableBuffer = 1;
+
+    // The buffer owned by the consumer
+    isize consumerBuffer = 2;
+
+    /* The buffer waiting to be picked up by the consumer. Bit 2 is set if
+     * this buffer contains a frame the consumer hasn't seen yet.
+     */
+    static constexpr u8 freshFrame = 0b100;
+    std::atomic<u8> pendingBuffer = 1;
+
+    // Sequence number of the most recently completed frame
+    std::atomic<i64> frameSeq = 0;
+
+    // Wakes up all threads waiting for a new frame
+    std::mutex frameMutex;
+    std::condition_variable frameReady;
 
     // Buffer with background noise (random black and white pixels)
     Buffer <Texel> noise;
@@ -85,6 +108,84 @@ public:
     RegChangeRecorder<128> colChanges;
 
 
+    //
+    // Dirty line tracking
+    //
+
+private:
+
+    /* Hash values of the inputs the lines of all frame buffers have been
+     * computed from. colorize() skips a line if the working buffer already
+     * holds a line computed from the same inputs. A value of 0 indicates
+     * that a line has to be recomputed.
+     */
+    u64 lineHash[3][VPIXELS] = {};
+
+    // Skipped lines (statistics)
+    isize skippedLines = 0;
+    isize colorizedLines = 0;
+
+
+    //
+    // Colorization pipeline
+    //
+
+    // All data needed to colorize a single rasterline
+    struct ColorJob {
+
+        // Target line in the working buffer
+        FrameBuffer *frame;
+        isize line;
+        Texel *dst;
+
+        // Color state at the beginning of the line
+        AmigaColor color[32];
+        Texel palette[paletteCnt];
+        bool hamMode;
+        bool shresMode;
+
+        // Color register changes in this line
+        isize changeCnt;
+        i64 keys[128];
+        RegChange changes[128];
+
+        // Pixel data provided by Denise (one of Denise's line buffer sets)
+        const u8 *bBuffer;
+        const u8 *iBuffer;
+        const u8 *mBuffer;
+        const u16 *zBuffer;
+
+        // Post-processing steps
+        bool clearLastPixel;
+        bool hiresMarker;
+    };
+
+    /* Ring buffer connecting the emulator thread with the worker thread. The
+     * emulator thread fills the slot at jobHead and publishes it by
+     * incrementing jobHead once the line has been finalized. The worker
+     * thread colorizes all lines between jobTail and jobHead. The job in slot
+     * n reads its pixel data from Denise's n-th set of line buffers.
+     */
+    static constexpr isize jobCapacity = 64;
+    std::vector<ColorJob> jobs;
+    std::atomic<isize> jobHead = 0;
+    std::atomic<isize> jobTail = 0;
+
+    // Number of pending lines that wakes up the worker thread
+    static constexpr isize jobBatch = 16;
+
+    // Indicates whether the slot at jobHead is filled, but not published
+    bool jobStaged = false;
+
+    // The worker thread
+    std::thread worker;
+    std::atomic<bool> workerRunning = false;
+    util::Wakeable workerWakeup;
+
+    // Wakes up the emulator thread when the worker thread has finished a line
+    util::Wakeable jobDone;
+
+
     //
     // Initializing
     //
@@ -92,10 +193,14 @@ public:
 public:
     
     PixelEngine(Amiga& ref);
+    ~PixelEngine();
 
-    // Initializes both frame buffers with a checkerboard pattern
+    // Initializes all frame buffers with a checkerboard pattern
     void clearAll();
 
+    // Forces all lines to be recomputed
+    void invalidateLines();
+
 
     //
     // Methods from AmigaObject
@@ -208,10 +313,30 @@ private:
 
 public:
 
-    // Returns the working buffer or the stable buffer
+    // Returns the working buffer or the most recently completed buffer
     FrameBuffer &getWorkingBuffer();
     const FrameBuffer &getStableBuffer();
 
+    /* Hands the most recently completed frame over to the consumer. The
+     * returned buffer remains untouched by the emulator until this function
+     * is called again. It must be called by a single consumer thread only.
+     */
+    const FrameBuffer &acquireStableBuffer();
+
+    // Returns the buffer most recently handed over to the consumer
+    const FrameBuffer &getConsumerBuffer() const { return emuTexture[consumerBuffer]; }
+
+    // Returns the sequence number of the most recently completed frame
+    i64 getFrameSeq() const { return frameSeq; }
+
+    /* Blocks the calling thread until a frame with a sequence number greater
+     * than seq has been completed or a timeout occurs. Returns the sequence
+     * number of the most recently completed frame. Any number of threads may
+     * wait at the same time. Each of them passes the sequence number it has
+     * seen last.
+     */
+    i64 waitForFrame(i64 seq, util::Time timeout);
+
     // Return a pointer into the pixel storage
     Texel *workingPtr(isize row = 0, isize col = 0);
     Texel *stablePtr(isize row = 0, isize col = 0);
@@ -241,6 +366,36 @@ public:
     void applyRegisterChange(const RegChange &change);
 
 
+    //
+    // Running the colorization pipeline
+    //
+
+public:
+
+    // Launches or terminates the worker thread
+    void startPipeline();
+    void stopPipeline();
+
+    // Waits until the worker thread has colorized all pending lines
+    void flushPipeline();
+
+    // Post-processing steps applied after a line has been colorized
+    void clearLastPixel(isize line);
+    void setHiresMarker(isize line, bool value);
+
+private:
+
+    // Indicates whether the next line is handed over to the worker thread
+    bool isPipelined() const;
+
+    // Prepares a job for the worker thread and passes it over
+    void stageJob(isize line);
+    void publishJob();
+
+    // Main entry point of the worker thread
+    void workerMain();
+
+
     //
     // Synthesizing pixels
     //
@@ -254,10 +409,26 @@ public:
     void colorize(isize line);
     
 private:
-    
-    void colorize(Texel *dst, Pixel from, Pixel to);
-    void colorizeSHRES(Texel *dst, Pixel from, Pixel to);
-    void colorizeHAM(Texel *dst, Pixel from, Pixel to, AmigaColor& ham);
+
+    // Indicates whether the texture is modified after colorization
+    bool hasOverlays() const;
+
+    // Indicates whether unchanged lines may be skipped by colorize()
+    bool canSkipLines() const;
+
+    // Computes a hash value of all inputs that determine the texels of a line
+    u64 computeLineHash() const;
+
+    // Colorizes a rasterline inside the worker thread
+    void colorize(ColorJob &job) const;
+
+    void colorize(Texel *dst, const u8 *mbuf,
+                  const Texel *pal, Pixel from, Pixel to) const;
+    void colorizeSHRES(Texel *dst, const u8 *mbuf, const u16 *zbuf,
+                       const Texel *pal, Pixel from, Pixel to) const;
+    void colorizeHAM(Texel *dst, const u8 *bbuf, const u8 *ibuf, const u8 *mbuf,
+                     const u16 *zbuf, const Texel *pal, const AmigaColor *col,
+                     Pixel from, Pixel to, AmigaColor& ham) const;
     
     /* Hides some graphics layers. This function is an optional stage applied
      * after colorize(). It can be used to hide some layers for debugging.
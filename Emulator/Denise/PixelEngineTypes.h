@@ -62,5 +62,6 @@ typedef struct
     isize brightness;
     isize contrast;
     isize saturation;
+    bool pipeline;
 }
 PixelEngineConfig;
@@ -0,0 +1,237 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#include "config.h"
+#include "AviWriter.h"
+#include "Error.h"
+#include "ImageUtils.h"
+#include <algorithm>
+#include <cmath>
+
+namespace vamiga {
+
+// Converts a four character code into a little endian value
+static constexpr u32 fourcc(const char *s)
+{
+    return u32(s[0]) | u32(s[1]) << 8 | u32(s[2]) << 16 | u32(s[3]) << 24;
+}
+
+void
+AviWriter::open(const string &path, isize width, isize height, isize frameRate, isize sampleRate)
+{
+    close();
+
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) throw VAError(ERROR_FILE_CANT_CREATE, path);
+
+    this->width = width;
+    this->height = height;
+    this->frameRate = frameRate;
+    this->sampleRate = sampleRate;
+
+    frames = 0;
+    samples = 0;
+    moviSize = 4;
+    index.clear();
+
+    // Write a preliminary header (sizes are filled in when the file is closed)
+    writeHeader();
+}
+
+void
+AviWriter::writeHeader()
+{
+    auto put16 = [&](u16 value) { file.put(char(value)); file.put(char(value >> 8)); };
+    auto put32 = [&](u32 value) { put16(u16(value)); put16(u16(value >> 16)); };
+    auto fcc = [&](const char *s) { put32(fourcc(s)); };
+
+    auto frameSize = u32(3 * width * height);
+    auto indexSize = u32(8 + 4 * index.size());
+    auto usec = u32(1000000 / frameRate);
+
+    // RIFF header
+    fcc("RIFF");
+    put32(u32(4 + 300 + 8 + moviSize + indexSize));
+    fcc("AVI ");
+
+    // Header list
+    fcc("LIST");
+    put32(292);
+    fcc("hdrl");
+
+    // Main header
+    fcc("avih");
+    put32(56);
+    put32(usec);                                // Microseconds per frame
+    put32(0);                                   // Max bytes per second
+    put32(0);                                   // Padding granularity
+    put32(0x10);                                // Flags (has index)
+    put32(u32(frames));                         // Total frames
+    put32(0);                                   // Initial frames
+    put32(2);                                   // Streams
+    put32(frameSize);                           // Suggested buffer size
+    put32(u32(width));
+    put32(u32(height));
+    for (isize i = 0; i < 4; i++) put32(0);     // Reserved
+
+    // Video stream
+    fcc("LIST");
+    put32(116);
+    fcc("strl");
+    fcc("strh");
+    put32(56);
+    fcc("vids");
+    fcc("MPNG");
+    put32(0);                                   // Flags
+    put16(0);                                   // Priority
+    put16(0);                                   // Language
+    put32(0);                                   // Initial frames
+    put32(1);                                   // Scale
+    put32(u32(frameRate));                      // Rate
+    put32(0);                                   // Start
+    put32(u32(frames));                         // Length
+    put32(frameSize);                           // Suggested buffer size
+    put32(u32(-1));                             // Quality
+    put32(0);                                   // Sample size
+    put16(0);                                   // Frame rectangle
+    put16(0);
+    put16(u16(width));
+    put16(u16(height));
+    fcc("strf");
+    put32(40);
+    put32(40);                                  // Header size
+    put32(u32(width));
+    put32(u32(height));
+    put16(1);                                   // Planes
+    put16(24);                                  // Bits per pixel
+    fcc("MPNG");                                // Compression
+    put32(frameSize);                           // Image size
+    put32(0);                                   // Horizontal resolution
+    put32(0);                                   // Vertical resolution
+    put32(0);                                   // Used colors
+    put32(0);                                   // Important colors
+
+    // Audio stream
+    fcc("LIST");
+    put32(92);
+    fcc("strl");
+    fcc("strh");
+    put32(56);
+    fcc("auds");
+    put32(0);                                   // Handler
+    put32(0);                                   // Flags
+    put16(0);                                   // Priority
+    put16(0);                                   // Language
+    put32(0);                                   // Initial frames
+    put32(1);                                   // Scale
+    put32(u32(sampleRate));                     // Rate
+    put32(0);                                   // Start
+    put32(u32(samples));                        // Length
+    put32(u32(4 * sampleRate / frameRate));     // Suggested buffer size
+    put32(u32(-1));                             // Quality
+    put32(4);                                   // Sample size
+    for (isize i = 0; i < 4; i++) put16(0);     // Frame rectangle
+    fcc("strf");
+    put32(16);
+    put16(1);                                   // PCM
+    put16(2);                                   // Channels
+    put32(u32(sampleRate));                     // Sample rate
+    put32(u32(4 * sampleRate));                 // Byte rate
+    put16(4);                                   // Block align
+    put16(16);                                  // Bits per sample
+
+    // Data list
+    fcc("LIST");
+    put32(u32(moviSize));
+    fcc("movi");
+}
+
+bool
+AviWriter::writeChunk(u32 id, const u8 *data, isize size)
+{
+    auto padded = size + (size & 1);
+
+    index.push_back(id);
+    index.push_back(0x10);
+    index.push_back(u32(moviSize));
+    index.push_back(u32(size));
+
+    u8 header[8] = {
+        u8(id), u8(id >> 8), u8(id >> 16), u8(id >> 24),
+        u8(size), u8(size >> 8), u8(size >> 16), u8(size >> 24)
+    };
+    file.write((const char *)header, 8);
+    file.write((const char *)data, size);
+    if (size & 1) file.put(0);
+
+    moviSize += 8 + padded;
+    return file.good();
+}
+
+bool
+AviWriter::writeVideo(const u32 *texels)
+{
+    assert(isOpen());
+
+    // Strip off the alpha channel
+    auto *src = (const u8 *)texels;
+    rgb.resize(3 * width * height);
+    for (isize i = 0; i < width * height; i++) {
+
+        rgb[3 * i + 0] = src[4 * i + 0];
+        rgb[3 * i + 1] = src[4 * i + 1];
+        rgb[3 * i + 2] = src[4 * i + 2];
+    }
+
+    // Compress the frame
+    png.clear();
+    util::encodePNG(rgb.data(), width, height, png);
+
+    frames++;
+    return writeChunk(fourcc("00dc"), png.data(), isize(png.size()));
+}
+
+bool
+AviWriter::writeAudio(const float *samples, isize count)
+{
+    assert(isOpen());
+
+    // Convert to 16-bit integers
+    pcm.resize(2 * count);
+    for (isize i = 0; i < 2 * count; i++) {
+
+        auto value = std::lround(samples[i] * 32767.0f);
+        pcm[i] = i16(std::clamp(value, -32768L, 32767L));
+    }
+
+    this->samples += count;
+    return writeChunk(fourcc("01wb"), (const u8 *)pcm.data(), 4 * count);
+}
+
+void
+AviWriter::close()
+{
+    if (!isOpen()) return;
+
+    // Write the index
+    auto put32 = [&](u32 value) {
+        u8 bytes[4] = { u8(value), u8(value >> 8), u8(value >> 16), u8(value >> 24) };
+        file.write((const char *)bytes, 4);
+    };
+    put32(fourcc("idx1"));
+    put32(u32(4 * index.size()));
+    for (auto &it : index) put32(it);
+
+    // Rewrite the header with the final values
+    file.seekp(0);
+    writeHeader();
+    file.close();
+}
+
+}
@@ -0,0 +1,95 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#pragma once
+
+#include "Aliases.h"
+#include "Exception.h"
+#include <fstream>
+#include <vector>
+
+namespace vamiga {
+
+/* This class writes an AVI file with a lossless video stream and a PCM audio
+ * stream. It is utilized by the screen recorder if no external encoder is
+ * used. Each frame is stored as a PNG image (codec "MPNG") which is supported
+ * by FFmpeg based players such as VLC or mpv. Audio is stored as 16-bit
+ * stereo samples.
+ *
+ * The header has a fixed size. It is written with preliminary values first
+ * and rewritten when the file gets closed, followed by the index chunk. Since all sizes are
+ * 32-bit values, the file is limited to 4 GB.
+ */
+
+class AviWriter {
+
+    // The output file
+    std::ofstream file;
+
+    // Stream properties
+    isize width = 0;
+    isize height = 0;
+    isize frameRate = 0;
+    isize sampleRate = 0;
+
+    // Number of written video frames and stereo samples
+    i64 frames = 0;
+    i64 samples = 0;
+
+    // Size of the 'movi' list (starting with the list type)
+    i64 moviSize = 0;
+
+    // Index entries (chunk id, flags, offset, size)
+    std::vector<u32> index;
+
+    // Scratch buffers
+    std::vector<u8> rgb;
+    std::vector<u8> png;
+    std::vector<i16> pcm;
+
+
+    //
+    // Initializing
+    //
+
+public:
+
+    ~AviWriter() { close(); }
+
+
+    //
+    // Writing
+    //
+
+public:
+
+    bool isOpen() const { return file.is_open(); }
+
+    // Creates the file and writes the headers
+    void open(const string &path, isize width, isize height, isize frameRate, isize sampleRate) throws;
+
+    // Writes a frame (RGBA texels, row by row)
+    bool writeVideo(const u32 *texels);
+
+    // Writes a block of interleaved stereo samples
+    bool writeAudio(const float *samples, isize count);
+
+    // Writes the index and fills in the header fields
+    void close();
+
+private:
+
+    // Writes all headers up to the start of the 'movi' list
+    void writeHeader();
+
+    // Writes a chunk into the 'movi' list and registers it in the index
+    bool writeChunk(u32 id, const u8 *data, isize size);
+};
+
+}
@@ -0,0 +1,113 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#include "config.h"
+#include "Encoder.h"
+#include "Chrono.h"
+
+namespace vamiga {
+
+void
+Encoder::start(isize videoSize, isize audioSize, Sink sink)
+{
+    stop();
+
+    for (isize i = 0; i < capacity; i++) {
+
+        slots[i].video.alloc(videoSize);
+        slots[i].audio.alloc(audioSize);
+    }
+
+    r = w = count = 0;
+    quit = false;
+    failed = false;
+    stalls = 0;
+
+    this->sink = sink;
+    worker = std::thread(&Encoder::main, this);
+}
+
+void
+Encoder::stop()
+{
+    if (!isRunning()) return;
+
+    // Let the encoder thread process all pending frames and terminate
+    mutex.lock();
+    quit = true;
+    mutex.unlock();
+    dataAvailable.wakeUp();
+    worker.join();
+
+    sink = nullptr;
+}
+
+EncoderFrame &
+Encoder::acquire()
+{
+    assert(isRunning());
+
+    while (true) {
+
+        mutex.lock();
+        bool full = count == capacity;
+        mutex.unlock();
+
+        if (!full) break;
+
+        stalls++;
+        spaceAvailable.waitForWakeUp(util::Time(100000000));
+    }
+
+    return slots[w];
+}
+
+void
+Encoder::submit()
+{
+    mutex.lock();
+    assert(count < capacity);
+    w = (w + 1) % capacity;
+    count++;
+    mutex.unlock();
+
+    dataAvailable.wakeUp();
+}
+
+void
+Encoder::main()
+{
+    while (true) {
+
+        mutex.lock();
+        isize pending = count;
+        bool done = quit;
+        mutex.unlock();
+
+        if (pending == 0) {
+
+            if (done) break;
+            dataAvailable.waitForWakeUp(util::Time(100000000));
+            continue;
+        }
+
+        // Pass the oldest frame to the sink (skip it after an error)
+        if (!failed && !sink(slots[r])) failed = true;
+
+        // Recycle the buffer
+        mutex.lock();
+        r = (r + 1) % capacity;
+        count--;
+        mutex.unlock();
+
+        spaceAvailable.wakeUp();
+    }
+}
+
+}
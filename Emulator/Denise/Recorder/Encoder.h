@@ -0,0 +1,121 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#pragma once
+
+#include "Aliases.h"
+#include "Buffer.h"
+#include "Concurrency.h"
+#include <atomic>
+#include <functional>
+#include <thread>
+
+namespace vamiga {
+
+// Video and audio data of a single frame
+struct EncoderFrame {
+
+    util::Buffer<u32> video;
+    util::Buffer<float> audio;
+};
+
+/* The encoder decouples the screen recorder from the sink that compresses and
+ * stores the recorded data. It owns a small ring of frame buffers which form a
+ * bounded queue. The emulator thread obtains a free buffer via acquire(),
+ * fills it in place, and hands it over by calling submit(). An encoder thread
+ * passes each submitted frame to the sink and recycles the buffer afterwards.
+ * Hence, no data is copied between the two threads.
+ *
+ * If the sink falls behind, acquire() blocks until a buffer is released. This
+ * slows down emulation, but no frame is ever lost. If the sink reports an
+ * error, all remaining frames are discarded and hasFailed() returns true.
+ */
+
+class Encoder {
+
+public:
+
+    // Consumer of encoded frames (returns false on failure)
+    typedef std::function<bool(const EncoderFrame &)> Sink;
+
+private:
+
+    // Number of frame buffers
+    static constexpr isize capacity = 4;
+
+    // The frame buffers
+    EncoderFrame slots[capacity];
+
+    // Read position, write position, and number of submitted frames
+    isize r = 0;
+    isize w = 0;
+    isize count = 0;
+    util::Mutex mutex;
+
+    // Signals for the encoder thread and the emulator thread
+    util::Wakeable dataAvailable;
+    util::Wakeable spaceAvailable;
+
+    // The encoder thread
+    std::thread worker;
+    Sink sink;
+    bool quit = false;
+
+    // Indicates whether the sink has reported an error
+    std::atomic<bool> failed = false;
+
+    // Number of times the emulator thread had to wait for a free buffer
+    std::atomic<i64> stalls = 0;
+
+
+    //
+    // Initializing
+    //
+
+public:
+
+    ~Encoder() { stop(); }
+
+
+    //
+    // Controlling
+    //
+
+public:
+
+    bool isRunning() const { return worker.joinable(); }
+    bool hasFailed() const { return failed; }
+    i64 getStalls() const { return stalls; }
+
+    // Allocates the frame buffers and launches the encoder thread
+    void start(isize videoSize, isize audioSize, Sink sink);
+
+    // Processes all pending frames and terminates the encoder thread
+    void stop();
+
+
+    //
+    // Exchanging frames
+    //
+
+public:
+
+    // Returns a free frame buffer (blocks if all buffers are in use)
+    EncoderFrame &acquire();
+
+    // Hands the most recently acquired buffer over to the encoder thread
+    void submit();
+
+private:
+
+    // Main function of the encoder thread
+    void main();
+};
+
+}
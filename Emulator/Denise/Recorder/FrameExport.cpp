@@ -0,0 +1,189 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#include "config.h"
+#include "FrameExport.h"
+#include "Amiga.h"
+#include "IOUtils.h"
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace vamiga {
+
+void
+FrameExport::_dump(Category category, std::ostream& os) const
+{
+    using namespace util;
+
+    if (category == Category::Inspection) {
+
+        os << tab("Shared memory");
+        os << (isActive() ? name : "Closed") << std::endl;
+
+        if (isActive()) {
+
+            os << tab("Size");
+            os << dec(mappedSize) << " Bytes" << std::endl;
+            os << tab("Published frames");
+            os << dec(header()->published.load()) << std::endl;
+            os << tab("Dropped samples");
+            os << dec(droppedSamples) << std::endl;
+        }
+    }
+}
+
+isize
+FrameExport::slotSize() const
+{
+    isize size = sizeof(SharedFrameSlot);
+    size += PIXELS * sizeof(Texel);
+    size += 2 * maxSamples * sizeof(float);
+
+    // Keep all slots cache line aligned
+    return (size + 63) & ~63;
+}
+
+SharedFrameSlot *
+FrameExport::slot(isize nr) const
+{
+    return (SharedFrameSlot *)(base + sizeof(SharedFrameHeader) + nr * slotSize());
+}
+
+void
+FrameExport::open(const string &name)
+{
+    close();
+
+#ifdef _WIN32
+
+    throw VAError(ERROR_FILE_CANT_CREATE, name);
+
+#else
+
+    auto size = isize(sizeof(SharedFrameHeader)) + slotCount * slotSize();
+
+    // Create the shared memory object
+    fd = ::shm_open(name.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
+    if (fd == -1) throw VAError(ERROR_FILE_CANT_CREATE, name);
+
+    if (::ftruncate(fd, size) == -1) {
+
+        ::close(fd);
+        fd = -1;
+        ::shm_unlink(name.c_str());
+        throw VAError(ERROR_FILE_CANT_CREATE, name);
+    }
+
+    // Map it into the address space
+    auto *ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (ptr == MAP_FAILED) {
+
+        ::close(fd);
+        fd = -1;
+        ::shm_unlink(name.c_str());
+        throw VAError(ERROR_FILE_CANT_CREATE, name);
+    }
+
+    this->name = name;
+    base = (u8 *)ptr;
+    mappedSize = size;
+
+    // Initialize the header (the slots are zeroed by ftruncate)
+    auto *hdr = header();
+    hdr->magic = 'V' << 24 | 'A' << 16 | 'F' << 8 | 'X';
+    hdr->version = 1;
+    hdr->slotCount = u32(slotCount);
+    hdr->slotSize = u32(slotSize());
+    hdr->width = HPIXELS * TPP;
+    hdr->height = VPIXELS;
+    hdr->sampleRate = u32(host.getSampleRate());
+    hdr->maxSamples = u32(maxSamples);
+    hdr->published.store(0, std::memory_order_release);
+
+    audio.clear();
+    audio.reserve(2 * maxSamples);
+    droppedSamples = 0;
+
+#endif
+}
+
+void
+FrameExport::close()
+{
+    if (!isActive()) return;
+
+#ifndef _WIN32
+
+    ::munmap(base, mappedSize);
+    ::close(fd);
+
+    // Readers which have mapped the object keep access to it
+    ::shm_unlink(name.c_str());
+
+#endif
+
+    base = nullptr;
+    fd = -1;
+    mappedSize = 0;
+}
+
+void
+FrameExport::addAudio(const float *left, const float *right, isize count)
+{
+    if (!isActive()) return;
+
+    auto space = maxSamples - isize(audio.size()) / 2;
+    if (count > space) {
+
+        droppedSamples += count - space;
+        count = space;
+    }
+
+    for (isize i = 0; i < count; i++) {
+
+        audio.push_back(left[i] * AUD_SCALE);
+        audio.push_back(right[i] * AUD_SCALE);
+    }
+}
+
+void
+FrameExport::eofHandler()
+{
+    if (!isActive()) return;
+
+    auto &frame = pixelEngine.getStableBuffer();
+    auto *hdr = header();
+
+    u64 nr = hdr->published.load(std::memory_order_relaxed) + 1;
+    auto *s = slot(isize((nr - 1) % slotCount));
+    auto *texels = (u8 *)s + sizeof(SharedFrameSlot);
+    auto *samples = texels + PIXELS * sizeof(Texel);
+
+    // Mark the slot as being written
+    s->seq.store(2 * nr - 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    // Copy the frame and the audio samples
+    s->frame = frame.nr;
+    s->longFrame = frame.longFrame;
+    s->samples = u32(audio.size() / 2);
+    std::memcpy(texels, frame.pixels.ptr, PIXELS * sizeof(Texel));
+    std::memcpy(samples, audio.data(), audio.size() * sizeof(float));
+
+    // Publish the slot
+    s->seq.store(2 * nr, std::memory_order_release);
+    hdr->published.store(nr, std::memory_order_release);
+
+    audio.clear();
+}
+
+}
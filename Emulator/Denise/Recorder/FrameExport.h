@@ -0,0 +1,162 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#pragma once
+
+#include "SubComponent.h"
+#include <atomic>
+#include <vector>
+
+namespace vamiga {
+
+/* Layout of the shared memory object
+ *
+ * The object starts with a header, followed by a ring of equally sized
+ * slots. Each slot starts with a slot header, followed by the frame buffer
+ * (width * height RGBA pixels, 32 bit each) and the audio samples of the frame
+ * (interleaved stereo floats, 2 * maxSamples). All headers are 64 bytes
+ * in size. All values are stored in host byte order.
+ *
+ * The n-th published frame (n = 1, 2, ...) is stored in slot (n - 1) %
+ * slotCount. While it is written, the slot's sequence counter is 2n - 1.
+ * Once the frame is complete, the counter is set to 2n and the published
+ * counter in the main header is set to n. Readers never block the emulator.
+ * They read the sequence counter, copy the data, and read the counter again.
+ * The copied data is valid if both values are equal and even.
+ */
+
+struct alignas(64) SharedFrameHeader {
+
+    u32 magic;                      // 0x56414658 ('VAFX')
+    u32 version;                    // Layout version (1)
+    u32 slotCount;                  // Number of slots
+    u32 slotSize;                   // Distance between two slots in bytes
+    u32 width;                      // Pixels per row
+    u32 height;                     // Number of rows
+    u32 sampleRate;                 // Audio sample rate in Hz
+    u32 maxSamples;                 // Audio capacity of a slot (stereo samples)
+    std::atomic<u64> published;     // Number of published frames
+};
+
+struct alignas(64) SharedFrameSlot {
+
+    std::atomic<u64> seq;           // Sequence counter
+    i64 frame;                      // Frame number
+    u32 longFrame;                  // 1 = long frame, 0 = short frame
+    u32 samples;                    // Number of stored stereo samples
+};
+
+static_assert(std::atomic<u64>::is_always_lock_free);
+static_assert(sizeof(SharedFrameHeader) == 64);
+static_assert(sizeof(SharedFrameSlot) == 64);
+
+/* The frame exporter publishes each completed frame buffer, together with the
+ * audio samples synthesized during that frame, in a POSIX shared memory
+ * object. It allows any number of local processes to observe the emulator
+ * output without going through the GUI or the file system.
+ */
+
+class FrameExport : public SubComponent {
+
+    // Number of slots in the ring
+    static constexpr isize slotCount = 4;
+
+    // Maximum number of stereo samples stored per frame
+    static constexpr isize maxSamples = 4096;
+
+    // Name of the shared memory object
+    string name;
+
+    // File descriptor and mapping of the shared memory object
+    int fd = -1;
+    u8 *base = nullptr;
+    isize mappedSize = 0;
+
+    // Audio samples of the current frame (interleaved)
+    std::vector<float> audio;
+
+    // Number of samples that did not fit into a slot
+    i64 droppedSamples = 0;
+
+
+    //
+    // Initializing
+    //
+
+public:
+
+    using SubComponent::SubComponent;
+    ~FrameExport() { close(); }
+
+
+    //
+    // Methods from AmigaObject
+    //
+
+private:
+
+    const char *getDescription() const override { return "FrameExport"; }
+    void _dump(Category category, std::ostream& os) const override;
+
+
+    //
+    // Methods from AmigaComponent
+    //
+
+private:
+
+    void _reset(bool hard) override { };
+
+    template <class T>
+    void applyToPersistentItems(T& worker) { }
+
+    template <class T>
+    void applyToResetItems(T& worker, bool hard = true) { }
+
+    isize _size() override { COMPUTE_SNAPSHOT_SIZE }
+    u64 _checksum() override { COMPUTE_SNAPSHOT_CHECKSUM }
+    isize _load(const u8 *buffer) override { LOAD_SNAPSHOT_ITEMS }
+    isize _save(u8 *buffer) override { SAVE_SNAPSHOT_ITEMS }
+
+
+    //
+    // Controlling
+    //
+
+public:
+
+    bool isActive() const { return base != nullptr; }
+
+    // Creates the shared memory object (e.g., "/vamiga")
+    void open(const string &name) throws;
+
+    // Unmaps and removes the shared memory object
+    void close();
+
+
+    //
+    // Exporting
+    //
+
+public:
+
+    // Adds a block of stereo samples to the current frame
+    void addAudio(const float *left, const float *right, isize count);
+
+    // Publishes the most recently completed frame
+    void eofHandler();
+
+private:
+
+    isize slotSize() const;
+    SharedFrameHeader *header() const { return (SharedFrameHeader *)base; }
+    SharedFrameSlot *slot(isize nr) const;
+};
+
+}
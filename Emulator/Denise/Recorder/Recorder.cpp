@@ -10,6 +10,7 @@
 #include "config.h"
 #include "Recorder.h"
 #include "Amiga.h"
+#include "IOUtils.h"
 
 namespace vamiga {
 
@@ -50,6 +51,10 @@ Recorder::_dump(Category category, std::ostream& os) const
         os << bol(FFmpeg::available()) << std::endl;
         os << tab("Recording");
         os << bol(isRecording()) << std::endl;
+        os << tab("Encoder");
+        os << (builtin ? "Built-in (AVI / PNG)" : "FFmpeg") << std::endl;
+        os << tab("Stalls");
+        os << dec(encoder.getStalls()) << std::endl;
     }
 }
 
@@ -77,6 +82,12 @@ Recorder::audioStreamPath()
     return amiga.tmp("audio.mp4").string();
 }
 
+string
+Recorder::aviPath()
+{
+    return amiga.tmp("video.avi").string();
+}
+
 util::Time
 Recorder::getDuration() const
 {
@@ -86,34 +97,22 @@ Recorder::getDuration() const
 void
 Recorder::startRecording(isize x1, isize y1, isize x2, isize y2,
                          isize bitRate,
-                         isize aspectX, isize aspectY)
+                         isize aspectX, isize aspectY,
+                         bool builtin)
 {
     debug(REC_DEBUG, "startRecording()");
 
     SYNCHRONIZED
 
-    debug(REC_DEBUG, "startRecording(%ld,%ld,%ld,%ld,%ld,%ld,%ld)\n",
-          x1, y1, x2, y2, bitRate, aspectX, aspectY);
+    debug(REC_DEBUG, "startRecording(%ld,%ld,%ld,%ld,%ld,%ld,%ld,%d)\n",
+          x1, y1, x2, y2, bitRate, aspectX, aspectY, builtin);
     
     if (isRecording()) {
         throw VAError(ERROR_REC_LAUNCH, "Recording in progress.");
     }
-    
-    // Create pipes
-    debug(REC_DEBUG, "Creating pipes...\n");
-    
-    if (!videoPipe.create(videoPipePath())) {
-        throw VAError(ERROR_REC_LAUNCH, "Failed to create the video encoder pipe.");
-    }
-    if (!audioPipe.create(audioPipePath())) {
-        throw VAError(ERROR_REC_LAUNCH, "Failed to create the video encoder pipe.");
-    }
-    
-    debug(REC_DEBUG, "Pipes created\n");
-    dump(Category::Inspection);
-    
-    debug(REC_DEBUG, "startRecording(%ld,%ld,%ld,%ld,%ld,%ld,%ld)\n",
-          x1, y1, x2, y2, bitRate, aspectX, aspectY);
+
+    // Fall back to the built-in encoder if FFmpeg is not installed
+    this->builtin = builtin || !FFmpeg::available();
 
     // Make sure the screen dimensions are even
     if ((x2 - x1) % 2) x2--;
@@ -131,12 +130,64 @@ Recorder::startRecording(isize x1, isize y1, isize x2, isize y2,
     frameRate = 50;
     sampleRate = 44100;
     samplesPerFrame = sampleRate / frameRate;
+
+    isize width = x2 - x1;
+    isize height = y2 - y1;
+
+    if (this->builtin) {
+
+        // Create the output file
+        debug(REC_DEBUG, "Opening %s\n", aviPath().c_str());
+
+        try {
+            aviWriter.open(aviPath(), width, height, frameRate, sampleRate);
+        } catch (...) {
+            throw VAError(ERROR_REC_LAUNCH, "Unable to create the output file.");
+        }
+
+        // Let the encoder thread compress and store the frames
+        encoder.start(width * height, 2 * samplesPerFrame, [this](const EncoderFrame &frame) {
+
+            return
+            aviWriter.writeVideo(frame.video.ptr) &&
+            aviWriter.writeAudio(frame.audio.ptr, samplesPerFrame);
+        });
+
+    } else {
+
+        launchFFmpeg(aspectX, aspectY);
+
+        // Let the encoder thread feed the pipes
+        encoder.start(width * height, 2 * samplesPerFrame, [this](const EncoderFrame &frame) {
+
+            isize length1 = frame.video.bytesize();
+            isize length2 = 2 * sizeof(float) * samplesPerFrame;
+
+            return
+            videoPipe.write((u8 *)frame.video.ptr, length1) == length1 &&
+            audioPipe.write((u8 *)frame.audio.ptr, length2) == length2;
+        });
+    }
     
-    // Create temporary buffers
-    debug(REC_DEBUG, "Creating buffers...\n");
+    debug(REC_DEBUG, "Success\n");
+    state = State::prepare;
+}
 
-    videoData.alloc((x2 - x1) * (y2 - y1));
-    audioData.alloc(2 * samplesPerFrame);
+void
+Recorder::launchFFmpeg(isize aspectX, isize aspectY)
+{
+    // Create pipes
+    debug(REC_DEBUG, "Creating pipes...\n");
+    
+    if (!videoPipe.create(videoPipePath())) {
+        throw VAError(ERROR_REC_LAUNCH, "Failed to create the video encoder pipe.");
+    }
+    if (!audioPipe.create(audioPipePath())) {
+        throw VAError(ERROR_REC_LAUNCH, "Failed to create the video encoder pipe.");
+    }
+    
+    debug(REC_DEBUG, "Pipes created\n");
+    dump(Category::Inspection);
     
     //
     // Assemble the command line arguments for the video encoder
@@ -157,7 +208,8 @@ Recorder::startRecording(isize x1, isize y1, isize x2, isize y2,
     cmd1 += " -r " + std::to_string(frameRate);
     
     // Frame size (width x height)
-    cmd1 += " -s:v " + std::to_string(x2 - x1) + "x" + std::to_string(y2 - y1);
+    cmd1 += " -s:v " + std::to_string(cutout.x2 - cutout.x1);
+    cmd1 += "x" + std::to_string(cutout.y2 - cutout.y1);
     
     // Input source (named pipe)
     cmd1 += " -i " + videoPipePath();
@@ -237,9 +289,6 @@ Recorder::startRecording(isize x1, isize y1, isize x2, isize y2,
     if (!audioPipe.open()) {
         throw VAError(ERROR_REC_LAUNCH, "Unable to launch the audio pipe.");
     }
-    
-    debug(REC_DEBUG, "Success\n");
-    state = State::prepare;
 }
 
 void
@@ -261,6 +310,24 @@ Recorder::exportAs(const string &path)
     debug(REC_DEBUG, "exportAs()\n");
 
     if (isRecording()) return false;
+
+    // The built-in encoder has already produced the final file
+    if (builtin) {
+
+        // It can only be exported into a file with a matching extension
+        if (util::lowercased(util::extractSuffix(path)) != "avi") {
+            warn("The built-in encoder can't write %s (AVI only)\n", path.c_str());
+            return false;
+        }
+
+        try {
+            fs::copy_file(aviPath(), path, fs::copy_options::overwrite_existing);
+        } catch (...) {
+            warn("Failed to copy %s to %s\n", aviPath().c_str(), path.c_str());
+            return false;
+        }
+        return true;
+    }
     
     //
     // Assemble the command line arguments for the video encoder
@@ -328,17 +395,21 @@ Recorder::prepare()
 void
 Recorder::record(Cycle target)
 {
-    assert(videoFFmpeg.isRunning());
-    assert(audioFFmpeg.isRunning());
-    assert(videoPipe.isOpen());
-    assert(audioPipe.isOpen());
-    
-    recordVideo(target);
-    recordAudio(target);
+    assert(encoder.isRunning());
+
+    // Fill a free frame buffer and hand it over to the encoder thread
+    auto &frame = encoder.acquire();
+    recordVideo(target, frame.video.ptr);
+    recordAudio(target, frame.audio.ptr);
+    encoder.submit();
+
+    if (encoder.hasFailed() || FORCE_RECORDING_ERROR) {
+        state = State::abort;
+    }
 }
 
 void
-Recorder::recordVideo(Cycle target)
+Recorder::recordVideo(Cycle target, u32 *dst)
 {
     auto *buffer = denise.pixelEngine.stablePtr();
 
@@ -346,26 +417,16 @@ Recorder::recordVideo(Cycle target)
     isize height = cutout.y2 - cutout.y1;
     isize offset = cutout.y1 * HPIXELS + cutout.x1;
     u8 *src = (u8 *)(buffer + offset);
-    u8 *dst = (u8 *)videoData.ptr;
-
-    for (isize y = 0; y < height; y++, src += sizeof(u32) * HPIXELS, dst += width) {
-        std::memcpy(dst, src, width);
-    }
+    u8 *to = (u8 *)dst;
 
-    // Feed the video pipe
-    assert(videoPipe.isOpen());
-    isize length = width * height;
-    isize written = videoPipe.write((u8 *)videoData.ptr, length);
-
-    if (written != length || FORCE_RECORDING_ERROR) {
-        state = State::abort;
+    for (isize y = 0; y < height; y++, src += sizeof(u32) * HPIXELS, to += width) {
+        std::memcpy(to, src, width);
     }
 }
 
 void
-Recorder::recordAudio(Cycle target)
+Recorder::recordAudio(Cycle target, float *dst)
 {
-    
     // Clone Paula's muxer contents
     muxer.sampler[0] = paula.muxer.sampler[0];
     muxer.sampler[1] = paula.muxer.sampler[1];
@@ -382,16 +443,7 @@ Recorder::recordAudio(Cycle target)
     audioClock = target;
     
     // Copy samples to buffer
-    muxer.copy(audioData.ptr, samplesPerFrame);
-    
-    // Feed the audio pipe
-    assert(audioPipe.isOpen());
-    isize length = 2 * sizeof(float) * samplesPerFrame;
-    isize written = audioPipe.write((u8 *)audioData.ptr, length);
-
-    if (written != length || FORCE_RECORDING_ERROR) {
-        state = State::abort;
-    }
+    muxer.copy(dst, samplesPerFrame);
 }
 
 void
@@ -399,13 +451,24 @@ Recorder::finalize()
 {
     debug(REC_DEBUG, "finalize()\n");
 
-    // Close pipes
-    videoPipe.close();
-    audioPipe.close();
-    
-    // Wait for the decoders to terminate
-    videoFFmpeg.join();
-    audioFFmpeg.join();
+    // Process all pending frames
+    encoder.stop();
+
+    if (builtin) {
+
+        // Complete the output file
+        aviWriter.close();
+
+    } else {
+
+        // Close pipes
+        videoPipe.close();
+        audioPipe.close();
+
+        // Wait for the decoders to terminate
+        videoFFmpeg.join();
+        audioFFmpeg.join();
+    }
     
     // Switch state and inform the GUI
     state = State::wait;
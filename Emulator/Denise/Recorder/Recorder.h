@@ -10,7 +10,9 @@
 #pragma once
 
 #include "SubComponent.h"
+#include "AviWriter.h"
 #include "Chrono.h"
+#include "Encoder.h"
 #include "FFmpeg.h"
 #include "Muxer.h"
 #include "NamedPipe.h"
@@ -41,6 +43,12 @@ class Recorder : public SubComponent {
     NamedPipe videoPipe;
     NamedPipe audioPipe;
 
+    // Built-in file writer (used if FFmpeg is not utilized)
+    AviWriter aviWriter;
+
+    // Encoder thread feeding FFmpeg or the built-in file writer
+    Encoder encoder;
+
     
     //
     // Recording status
@@ -55,6 +63,9 @@ class Recorder : public SubComponent {
     // Audio has been recorded up to this cycle
     Cycle audioClock = 0;
 
+    // Indicates whether the built-in encoder is used instead of FFmpeg
+    bool builtin = false;
+
     
     //
     // Recording parameters
@@ -75,10 +86,6 @@ class Recorder : public SubComponent {
     util::Time recStart;
     util::Time recStop;
 
-    // Temporary storage for audio and video data
-    Buffer<u32> videoData;
-    Buffer<float> audioData;
-
     
     //
     // Initializing
@@ -132,6 +139,9 @@ private:
     string videoStreamPath();
     string audioStreamPath();
 
+    // Returns the path to the output file of the built-in encoder
+    string aviPath();
+
     //Returns the log level passed to FFmpeg
     const string loglevel() { return REC_DEBUG ? "verbose" : "warning"; }
 
@@ -160,7 +170,8 @@ public:
     // Starts the screen recorder
     void startRecording(isize x1, isize y1, isize x2, isize y2,
                         isize bitRate,
-                        isize aspectX, isize aspectY) throws;
+                        isize aspectX, isize aspectY,
+                        bool builtin = false) throws;
     
     // Stops the screen recorder
     void stopRecording();
@@ -180,10 +191,11 @@ public:
     
 private:
     
+    void launchFFmpeg(isize aspectX, isize aspectY) throws;
     void prepare();
     void record(Cycle target);
-    void recordVideo(Cycle target);
-    void recordAudio(Cycle target);
+    void recordVideo(Cycle target, u32 *dst);
+    void recordAudio(Cycle target, float *dst);
     void finalize();
     void abort();
 };
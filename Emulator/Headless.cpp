@@ -20,7 +20,7 @@ int main(int argc, char *argv[])
 {
     try {
         
-        vamiga::Headless().main(argc, argv);
+        return vamiga::Headless().main(argc, argv);
         
     } catch (vamiga::SyntaxError &e) {
         
@@ -59,7 +59,7 @@ int main(int argc, char *argv[])
 
 namespace vamiga {
 
-void
+int
 Headless::main(int argc, char *argv[])
 {
     std::cout << "vAmiga Headless v" << amiga.version();
@@ -86,6 +86,8 @@ Headless::main(int argc, char *argv[])
         barrier.lock();
         amiga.retroShell.continueScript();
     }
+
+    return returnCode;
 }
 
 #ifdef _WIN32
@@ -188,9 +190,13 @@ Headless::process(long type, i32 d1, i32 d2, i32 d3, i32 d4)
 
     switch (type) {
             
+        case MSG_ABORT:
+
+            returnCode = d1;
+            [[fallthrough]];
+
         case MSG_SCRIPT_DONE:
         case MSG_SCRIPT_ABORT:
-        case MSG_ABORT:
 
             halt = true;
             [[fallthrough]];
@@ -37,6 +37,9 @@ class Headless {
     // Exit flag
     bool halt = false;
 
+    // Return code passed to the operating system
+    int returnCode = 0;
+
     
     //
     // Launching
@@ -45,7 +48,7 @@ class Headless {
 public:
 
     // Main entry point
-    void main(int argc, char *argv[]);
+    int main(int argc, char *argv[]);
 
 private:
 
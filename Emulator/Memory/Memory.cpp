@@ -2314,7 +2314,7 @@ Memory::pokeCustom16(u32 addr, u16 value)
         case 0x09C >> 1: // INTREQ
             paula.pokeINTREQ<s>(value); return;
         case 0x09E >> 1: // ADKCON
-            paula.pokeADKCON(value); return;
+            paula.pokeADKCON<s>(value); return;
         case 0x0A0 >> 1: // AUD0LCH
             agnus.pokeAUDxLCH<0,s>(value); return;
         case 0x0A2 >> 1: // AUD0LCL
@@ -2322,11 +2322,11 @@ Memory::pokeCustom16(u32 addr, u16 value)
         case 0x0A4 >> 1: // AUD0LEN
             paula.channel0.pokeAUDxLEN(value); return;
         case 0x0A6 >> 1: // AUD0PER
-            paula.channel0.pokeAUDxPER(value); return;
+            paula.channel0.pokeAUDxPER<s>(value); return;
         case 0x0A8 >> 1: // AUD0VOL
-            paula.channel0.pokeAUDxVOL(value); return;
+            paula.channel0.pokeAUDxVOL<s>(value); return;
         case 0x0AA >> 1: // AUD0DAT
-            paula.channel0.pokeAUDxDAT(value); return;
+            paula.channel0.pokeAUDxDAT<s>(value); return;
         case 0x0AC >> 1: // Unused
         case 0x0AE >> 1: // Unused
             break;
@@ -2337,11 +2337,11 @@ Memory::pokeCustom16(u32 addr, u16 value)
         case 0x0B4 >> 1: // AUD1LEN
             paula.channel1.pokeAUDxLEN(value); return;
         case 0x0B6 >> 1: // AUD1PER
-            paula.channel1.pokeAUDxPER(value); return;
+            paula.channel1.pokeAUDxPER<s>(value); return;
         case 0x0B8 >> 1: // AUD1VOL
-            paula.channel1.pokeAUDxVOL(value); return;
+            paula.channel1.pokeAUDxVOL<s>(value); return;
         case 0x0BA >> 1: // AUD1DAT
-            paula.channel1.pokeAUDxDAT(value); return;
+            paula.channel1.pokeAUDxDAT<s>(value); return;
         case 0x0BC >> 1: // Unused
         case 0x0BE >> 1: // Unused
             break;
@@ -2352,11 +2352,11 @@ Memory::pokeCustom16(u32 addr, u16 value)
         case 0x0C4 >> 1: // AUD2LEN
             paula.channel2.pokeAUDxLEN(value); return;
         case 0x0C6 >> 1: // AUD2PER
-            paula.channel2.pokeAUDxPER(value); return;
+            paula.channel2.pokeAUDxPER<s>(value); return;
         case 0x0C8 >> 1: // AUD2VOL
-            paula.channel2.pokeAUDxVOL(value); return;
+            paula.channel2.pokeAUDxVOL<s>(value); return;
         case 0x0CA >> 1: // AUD2DAT
-            paula.channel2.pokeAUDxDAT(value); return;
+            paula.channel2.pokeAUDxDAT<s>(value); return;
         case 0x0CC >> 1: // Unused
         case 0x0CE >> 1: // Unused
             break;
@@ -2367,11 +2367,11 @@ Memory::pokeCustom16(u32 addr, u16 value)
         case 0x0D4 >> 1: // AUD3LEN
             paula.channel3.pokeAUDxLEN(value); return;
         case 0x0D6 >> 1: // AUD3PER
-            paula.channel3.pokeAUDxPER(value); return;
+            paula.channel3.pokeAUDxPER<s>(value); return;
         case 0x0D8 >> 1: // AUD3VOL
-            paula.channel3.pokeAUDxVOL(value); return;
+            paula.channel3.pokeAUDxVOL<s>(value); return;
         case 0x0DA >> 1: // AUD3DAT
-            paula.channel3.pokeAUDxDAT(value); return;
+            paula.channel3.pokeAUDxDAT<s>(value); return;
         case 0x0DC >> 1: // Unused
         case 0x0DE >> 1: // Unused
             break;
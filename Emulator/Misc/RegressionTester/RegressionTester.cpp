@@ -11,8 +11,12 @@
 #include "RegressionTester.h"
 #include "Amiga.h"
 #include "IOUtils.h"
+#include "ImageUtils.h"
 
+#include <algorithm>
 #include <fstream>
+#include <iomanip>
+#include <optional>
 
 namespace vamiga {
 
@@ -65,49 +69,191 @@ RegressionTester::dumpTexture(Amiga &amiga, const string &filename)
     /* This function is used for automatic regression testing. It dumps the
      * visible portion of the texture into the /tmp directory and exits the
      * application. The regression test script picks up the texture and
-     * compares it against a previously recorded reference image.
+     * compares it against a previously recorded reference image. If the
+     * filename ends with ".qoi", the texture is saved as a QOI image.
+     * Otherwise, the raw RGB values are written into a ".raw" file.
      */
-    std::ofstream file;
+    if (util::extractSuffix(filename) == "qoi") {
 
-    // Open an output stream
-    file.open(("/tmp/" + filename + ".raw").c_str());
-    
-    // Dump texture
-    dumpTexture(amiga, file);
-    file.close();
+        saveTexture(amiga, "/tmp/" + filename);
+
+    } else {
+
+        std::ofstream file("/tmp/" + filename + ".raw", std::ios::binary);
+        dumpTexture(amiga, file);
+    }
 
     // Ask the GUI to quit
-    msgQueue.put(MSG_ABORT, retValue);
+    exit();
 }
 
 void
 RegressionTester::dumpTexture(Amiga &amiga, std::ostream& os)
+{
+    std::vector<u8> rgb;
+    grabTexture(amiga, rgb);
+
+    os.write((const char *)rgb.data(), rgb.size());
+}
+
+void
+RegressionTester::appendTexture(Amiga &amiga, const string &filename)
+{
+    std::vector<u8> rgb, qoi;
+    grabTexture(amiga, rgb);
+
+    auto path = "/tmp/" + filename;
+    auto it = streams.find(filename);
+
+    // Create the file when the stream is used for the first time
+    if (it == streams.end()) {
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) throw VAError(ERROR_FILE_CANT_CREATE, path);
+
+        it = streams.emplace(filename, std::vector<u8>()).first;
+    }
+    auto &frame = it->second;
+
+    // Start over with a blank reference frame if the image size has changed
+    if (frame.size() != rgb.size()) frame.assign(rgb.size(), 0);
+
+    // Compute the difference to the previous frame
+    std::vector<u8> delta(rgb.size());
+    for (usize i = 0; i < rgb.size(); i++) delta[i] = rgb[i] ^ frame[i];
+
+    // Encode the difference and append it to the stream
+    qoi.resize(4);
+    util::encodeQOI(delta.data(), X2 - X1, Y2 - Y1, qoi);
+    u32 size = u32(qoi.size() - 4);
+    qoi[0] = u8(size >> 24); qoi[1] = u8(size >> 16); qoi[2] = u8(size >> 8); qoi[3] = u8(size);
+
+    std::ofstream file(path, std::ios::binary | std::ios::app);
+    if (!file.is_open()) throw VAError(ERROR_FILE_CANT_WRITE, path);
+    file.write((const char *)qoi.data(), qoi.size());
+    if (!file.good()) throw VAError(ERROR_FILE_CANT_WRITE, path);
+
+    // Keep the current frame as reference for the next one
+    frame.swap(rgb);
+}
+
+bool
+RegressionTester::checkTexture(Amiga &amiga, const string &name)
+{
+    std::ifstream manifest(manifestPath);
+    if (!manifest.is_open()) throw VAError(ERROR_FILE_NOT_FOUND, manifestPath);
+
+    auto hash = textureHash(amiga);
+    std::optional<u64> expected;
+
+    // Look up the expected hash value
+    for (string line; std::getline(manifest, line);) {
+
+        std::istringstream ss(line);
+        string key, value;
+
+        if (ss >> key >> value && key == name) {
+
+            // Reject malformed lines with a proper error code
+            try {
+
+                usize pos;
+                expected = std::stoull(value, &pos, 16);
+                if (pos != value.size()) throw std::invalid_argument(value);
+
+            } catch (std::exception &) {
+
+                throw VAError(ERROR_FILE_TYPE_MISMATCH, manifestPath);
+            }
+            break;
+        }
+    }
+
+    if (expected == hash) return true;
+
+    // Report the mismatch in manifest format
+    std::stringstream ss;
+    ss << name << " " << std::hex << std::setw(16) << std::setfill('0') << hash;
+    retroShell << "Mismatch: " << ss.str() << '\n';
+
+    // Save the test image for inspection
+    saveTexture(amiga, "/tmp/" + name + ".qoi");
+    setErrorCode(1);
+
+    return false;
+}
+
+void
+RegressionTester::exit()
+{
+    msgQueue.put(MSG_ABORT, retValue);
+}
+
+u64
+RegressionTester::textureHash(Amiga &amiga)
+{
+    auto xmin = std::clamp(x1, X1, X2), xmax = std::clamp(x2, xmin, X2);
+    auto ymin = std::clamp(y1, Y1, Y2), ymax = std::clamp(y2, ymin, Y2);
+    u64 result = util::fnvInit64();
+
+    {   SUSPENDED
+
+        Texel *ptr = amiga.denise.pixelEngine.stablePtr() - 4 * HBLANK_MIN;
+
+        // Hash the pixel area texel by texel
+        for (isize y = ymin; y < ymax; y++) {
+
+            auto row = ptr + y * HPIXELS;
+            for (isize x = xmin; x < xmax; x++) result = util::fnvIt64(result, row[x]);
+        }
+    }
+
+    return result;
+}
+
+void
+RegressionTester::saveTexture(Amiga &amiga, const string &path)
+{
+    std::vector<u8> rgb, qoi;
+    grabTexture(amiga, rgb);
+    util::encodeQOI(rgb.data(), X2 - X1, Y2 - Y1, qoi);
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) throw VAError(ERROR_FILE_CANT_CREATE, path);
+    file.write((const char *)qoi.data(), qoi.size());
+}
+
+void
+RegressionTester::grabTexture(Amiga &amiga, std::vector<u8> &rgb)
 {
     Texel grey2 = FrameBuffer::grey2;
     Texel grey4 = FrameBuffer::grey4;
 
     auto checkerboard = [&](isize y, isize x) {
-        return ((y >> 3) & 1) == ((x >> 3) & 1) ? (char *)&grey2 : (char *)&grey4;
+        return ((y >> 3) & 1) == ((x >> 3) & 1) ? (u8 *)&grey2 : (u8 *)&grey4;
     };
 
+    rgb.resize(3 * (X2 - X1) * (Y2 - Y1));
+    u8 *dst = rgb.data();
+
     {   SUSPENDED
-        
+
         Texel *ptr = amiga.denise.pixelEngine.stablePtr() - 4 * HBLANK_MIN;
-        char *cptr;
+        u8 *cptr;
 
         for (isize y = Y1; y < Y2; y++) {
-            
-            for (isize x = X1; x < X2; x++) {
+
+            for (isize x = X1; x < X2; x++, dst += 3) {
 
                 if (y >= y1 && y < y2 && x >= x1 && x < x2) {
-                    cptr = (char *)(ptr + y * HPIXELS + x);
+                    cptr = (u8 *)(ptr + y * HPIXELS + x);
                 } else {
                     cptr = checkerboard(y, x);
                 }
 
-                os.write(cptr + 0, 1);
-                os.write(cptr + 1, 1);
-                os.write(cptr + 2, 1);
+                dst[0] = cptr[0];
+                dst[1] = cptr[1];
+                dst[2] = cptr[2];
             }
         }
     }
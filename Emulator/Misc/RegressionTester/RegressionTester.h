@@ -12,6 +12,7 @@
 #include "SubComponent.h"
 #include "Constants.h"
 #include "AmigaTypes.h"
+#include <map>
 
 namespace vamiga {
 
@@ -28,6 +29,9 @@ public:
     // Filename of the test image
     string dumpTexturePath = "texture";
 
+    // Filename of the manifest with the expected texture hashes
+    string manifestPath;
+
     // Pixel area that is used for regression testing
     isize x1 = X1;
     isize y1 = Y1;
@@ -39,6 +43,11 @@ private:
     // When the emulator exits, this value is returned to the test script
     u8 retValue = 0;
 
+    /* Frame streams written by appendTexture(), each with its most recently
+     * appended frame (reference for delta compression)
+     */
+    std::map<string, std::vector<u8>> streams;
+
     
     //
     // Constructing
@@ -95,6 +104,36 @@ public:
     void dumpTexture(Amiga &amiga, const string &filename);
     void dumpTexture(Amiga &amiga, std::ostream& os);
 
+    /* Appends the test image to a frame stream. Each frame is XORed with its
+     * predecessor and stored as a QOI image, preceded by its size as a 32-bit
+     * big endian value. Since consecutive frames rarely differ much, most
+     * pixels end up in QOI run-length codes. The file is truncated when the
+     * stream is used for the first time. If the image size changes, the next
+     * frame is XORed with a blank frame.
+     */
+    void appendTexture(Amiga &amiga, const string &filename);
+
+    /* Compares the test image against the manifest. The manifest contains one
+     * line per test image, made up of its name and the expected hash value
+     * in hexadecimal notation. On a mismatch, the error code is set and the
+     * test image is saved as a QOI image in the /tmp directory.
+     */
+    bool checkTexture(Amiga &amiga, const string &name);
+
+    // Exits the emulator with the current error code
+    void exit();
+
+    // Computes a hash value for the pixel area used for regression testing
+    u64 textureHash(Amiga &amiga);
+
+private:
+
+    // Copies the test image into an RGB buffer
+    void grabTexture(Amiga &amiga, std::vector<u8> &rgb);
+
+    // Saves the test image as a QOI image
+    void saveTexture(Amiga &amiga, const string &path);
+
     
     //
     // Handling errors
@@ -0,0 +1,179 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#include "config.h"
+#include "AudioCapture.h"
+#include "Checksum.h"
+#include "Error.h"
+#include "IOUtils.h"
+#include <cstring>
+#include <iomanip>
+
+namespace vamiga {
+
+static void
+writeWavHeader(std::ofstream &os, isize sampleRate, i64 samples)
+{
+    auto put16 = [&](u16 value) { os.put(char(value)); os.put(char(value >> 8)); };
+    auto put32 = [&](u32 value) { put16(u16(value)); put16(u16(value >> 16)); };
+
+    assert(samples * 2 * sizeof(float) <= 0xFFFFFFFF - 36);
+    u32 dataSize = u32(samples * 2 * sizeof(float));
+
+    os.write("RIFF", 4);
+    put32(36 + dataSize);
+    os.write("WAVEfmt ", 8);
+    put32(16);
+    put16(3);                                   // IEEE float
+    put16(2);                                   // Channels
+    put32(u32(sampleRate));                     // Sample rate
+    put32(u32(sampleRate * 2 * sizeof(float))); // Byte rate
+    put16(2 * sizeof(float));                   // Block align
+    put16(8 * sizeof(float));                   // Bits per sample
+    os.write("data", 4);
+    put32(dataSize);
+}
+
+void
+AudioCapture::start(const string &path, isize sampleRate)
+{
+    stop();
+
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) throw VAError(ERROR_FILE_CANT_CREATE, path);
+    this->sampleRate = sampleRate;
+
+    // Write a preliminary header (sizes are filled in when recording stops)
+    wav = util::extractSuffix(path) == "wav";
+    if (wav) writeWavHeader(file, sampleRate, 0);
+
+    accepted = 0;
+    written = 0;
+    hash = util::fnvInit64();
+    frame = 0;
+    block.reserve(2 * blockSize);
+
+    // Launch the writer thread
+    quit = false;
+    writer = std::thread(&AudioCapture::writerMain, this);
+    active = true;
+}
+
+void
+AudioCapture::startHashing(const string &path)
+{
+    hashFile.open(path, std::ios::trunc);
+    if (!hashFile.is_open()) throw VAError(ERROR_FILE_CANT_CREATE, path);
+}
+
+void
+AudioCapture::stop()
+{
+    if (!isActive()) return;
+    active = false;
+
+    // Let the writer thread write out all pending blocks and terminate
+    flush();
+    queueMutex.lock();
+    quit = true;
+    queueMutex.unlock();
+    wakeable.wakeUp();
+    writer.join();
+
+    // Fill in the sizes of the WAV header
+    if (wav) {
+
+        file.seekp(0);
+        writeWavHeader(file, sampleRate, written);
+    }
+    file.close();
+    hashFile.close();
+}
+
+void
+AudioCapture::add(const float *left, const float *right, isize count)
+{
+    for (isize i = 0; i < count; i++) {
+
+        float l = left[i] * AUD_SCALE;
+        float r = right[i] * AUD_SCALE;
+
+        // Update the frame hash
+        u32 bits[2];
+        std::memcpy(bits, &l, 4);
+        std::memcpy(bits + 1, &r, 4);
+        hash = util::fnvIt64(hash, u64(bits[0]) << 32 | bits[1]);
+
+        // Drop the sample if the WAV file is full
+        if (wav && accepted == maxWavSamples) continue;
+        accepted++;
+
+        block.push_back(l);
+        block.push_back(r);
+        if (isize(block.size()) == 2 * blockSize) flush();
+    }
+}
+
+void
+AudioCapture::eofHandler()
+{
+    if (!isActive()) return;
+
+    if (hashFile.is_open()) {
+
+        hashFile << std::dec << frame << " ";
+        hashFile << std::hex << std::setw(16) << std::setfill('0') << hash << std::endl;
+    }
+
+    hash = util::fnvInit64();
+    frame++;
+}
+
+void
+AudioCapture::flush()
+{
+    if (block.empty()) return;
+
+    queueMutex.lock();
+    queue.push_back(std::move(block));
+    queueMutex.unlock();
+
+    block.clear();
+    block.reserve(2 * blockSize);
+    wakeable.wakeUp();
+}
+
+void
+AudioCapture::writerMain()
+{
+    std::vector<std::vector<float>> pending;
+
+    while (true) {
+
+        wakeable.waitForWakeUp(util::Time(100000000));
+
+        // Take over all queued blocks
+        queueMutex.lock();
+        pending.swap(queue);
+        bool done = quit;
+        queueMutex.unlock();
+
+        // Write them in one go each
+        for (auto &it : pending) {
+
+            file.write((const char *)it.data(), it.size() * sizeof(float));
+            written += isize(it.size()) / 2;
+        }
+        pending.clear();
+
+        if (done) break;
+    }
+}
+
+}
@@ -0,0 +1,129 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#pragma once
+
+#include "Aliases.h"
+#include "Concurrency.h"
+#include <atomic>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+namespace vamiga {
+
+/* The audio capture sink records the final output of the Muxer without the
+ * help of an external encoder. Samples are collected in large blocks which
+ * are handed over to a writer thread. Hence, the emulator thread never waits
+ * for the file system.
+ *
+ * If the file name ends with ".wav", the samples are written as a WAV file
+ * with 32-bit float samples. Otherwise, the interleaved float samples are
+ * written without a header. In addition, a 64-bit hash can be computed for
+ * the samples of each frame. These hashes are written into a separate text
+ * file and serve as golden values in audio regression tests.
+ *
+ * Since the sizes in a WAV header are 32-bit values, a WAV file is limited to
+ * 4 GB. Once this limit is reached, further samples are dropped. They still
+ * contribute to the frame hashes.
+ */
+
+class AudioCapture {
+
+    // Number of stereo samples per block
+    static constexpr isize blockSize = 65536;
+
+    // Maximum number of stereo samples fitting into a WAV file
+    static constexpr i64 maxWavSamples = (0xFFFFFFFF - 36) / (2 * sizeof(float));
+
+    // Output files
+    std::ofstream file;
+    std::ofstream hashFile;
+
+    // Indicates whether a WAV header has been written
+    bool wav = false;
+
+    // Sample rate stored in the WAV header
+    isize sampleRate = 0;
+
+    // Indicates whether recording is in progress (queried by other threads)
+    std::atomic<bool> active = false;
+
+    // Number of stereo samples accepted and written so far
+    i64 accepted = 0;
+    i64 written = 0;
+
+    // Block under construction (interleaved)
+    std::vector<float> block;
+
+    // Blocks waiting to be written
+    std::vector<std::vector<float>> queue;
+    util::Mutex queueMutex;
+
+    // The writer thread
+    std::thread writer;
+    util::Wakeable wakeable;
+    bool quit = false;
+
+    // Hash value of the current frame
+    u64 hash = 0;
+
+    // Number of recorded frames
+    i64 frame = 0;
+
+
+    //
+    // Initializing
+    //
+
+public:
+
+    ~AudioCapture() { stop(); }
+
+
+    //
+    // Controlling
+    //
+
+public:
+
+    bool isActive() const { return active; }
+
+    // Starts recording into a WAV file or a raw PCM file
+    void start(const string &path, isize sampleRate);
+
+    // Writes a hash value for each frame into a text file
+    void startHashing(const string &path);
+
+    // Flushes all pending samples and closes the files
+    void stop();
+
+
+    //
+    // Recording
+    //
+
+public:
+
+    // Adds a block of stereo samples
+    void add(const float *left, const float *right, isize count);
+
+    // Finishes the current frame
+    void eofHandler();
+
+private:
+
+    // Main function of the writer thread
+    void writerMain();
+
+    // Hands over the current block to the writer thread
+    void flush();
+};
+
+}
@@ -12,6 +12,10 @@
 #include "CIA.h"
 #include <cmath>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 namespace vamiga {
 
 void
@@ -171,4 +175,86 @@ AudioFilter::apply(float sample)
     return (float)y0;
 }
 
+void
+AudioFilter::apply(float *buffer, isize count)
+{
+    if (config.filterType == FILTER_NONE) return;
+
+    // Apply butterworth filter
+    assert(config.filterType == FILTER_BUTTERWORTH);
+
+    for (isize i = 0; i < count; i++) {
+
+        // Run pipeline
+        double x0 = (double)buffer[i];
+        double y0 = (b0 * x0) + (b1 * x1) + (b2 * x2) + (a1 * y1) + (a2 * y2);
+
+        // Shift pipeline
+        x2 = x1; x1 = x0;
+        y2 = y1; y1 = y0;
+
+        buffer[i] = (float)y0;
+    }
+}
+
+void
+AudioFilter::apply(AudioFilter &filterL, AudioFilter &filterR,
+                   float *left, float *right, isize count)
+{
+#ifdef __SSE2__
+
+    // Fall back to the single-channel code if one filter is bypassed
+    if (filterL.config.filterType != FILTER_BUTTERWORTH ||
+        filterR.config.filterType != FILTER_BUTTERWORTH) {
+
+        filterL.apply(left, count);
+        filterR.apply(right, count);
+        return;
+    }
+
+    // Load coefficients (low lane = left channel, high lane = right channel)
+    __m128d b0 = _mm_set_pd(filterR.b0, filterL.b0);
+    __m128d b1 = _mm_set_pd(filterR.b1, filterL.b1);
+    __m128d b2 = _mm_set_pd(filterR.b2, filterL.b2);
+    __m128d a1 = _mm_set_pd(filterR.a1, filterL.a1);
+    __m128d a2 = _mm_set_pd(filterR.a2, filterL.a2);
+
+    // Load pipelines
+    __m128d x1 = _mm_set_pd(filterR.x1, filterL.x1);
+    __m128d x2 = _mm_set_pd(filterR.x2, filterL.x2);
+    __m128d y1 = _mm_set_pd(filterR.y1, filterL.y1);
+    __m128d y2 = _mm_set_pd(filterR.y2, filterL.y2);
+
+    for (isize i = 0; i < count; i++) {
+
+        // Run pipeline
+        __m128d x0 = _mm_set_pd((double)right[i], (double)left[i]);
+        __m128d y0 = _mm_mul_pd(b0, x0);
+        y0 = _mm_add_pd(y0, _mm_mul_pd(b1, x1));
+        y0 = _mm_add_pd(y0, _mm_mul_pd(b2, x2));
+        y0 = _mm_add_pd(y0, _mm_mul_pd(a1, y1));
+        y0 = _mm_add_pd(y0, _mm_mul_pd(a2, y2));
+
+        // Shift pipeline
+        x2 = x1; x1 = x0;
+        y2 = y1; y1 = y0;
+
+        left[i] = (float)_mm_cvtsd_f64(y0);
+        right[i] = (float)_mm_cvtsd_f64(_mm_unpackhi_pd(y0, y0));
+    }
+
+    // Write back pipelines
+    filterL.x1 = _mm_cvtsd_f64(x1); filterR.x1 = _mm_cvtsd_f64(_mm_unpackhi_pd(x1, x1));
+    filterL.x2 = _mm_cvtsd_f64(x2); filterR.x2 = _mm_cvtsd_f64(_mm_unpackhi_pd(x2, x2));
+    filterL.y1 = _mm_cvtsd_f64(y1); filterR.y1 = _mm_cvtsd_f64(_mm_unpackhi_pd(y1, y1));
+    filterL.y2 = _mm_cvtsd_f64(y2); filterR.y2 = _mm_cvtsd_f64(_mm_unpackhi_pd(y2, y2));
+
+#else
+
+    filterL.apply(left, count);
+    filterR.apply(right, count);
+
+#endif
+}
+
 }
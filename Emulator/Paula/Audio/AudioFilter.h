@@ -115,6 +115,17 @@ public:
 
     // Inserts a sample into the filter pipeline
     float apply(float sample);
+
+    // Inserts a block of samples into the filter pipeline (in place)
+    void apply(float *buffer, isize count);
+
+    /* Runs a block of stereo samples through two filters at once. On hosts
+     * with SSE2 support, both channels are processed in parallel in the two
+     * lanes of a double-precision vector register. Hence, the result is
+     * bit-identical to running both filters separately.
+     */
+    static void apply(AudioFilter &filterL, AudioFilter &filterR,
+                      float *left, float *right, isize count);
 };
 
 }
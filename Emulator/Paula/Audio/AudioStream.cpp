@@ -24,26 +24,33 @@ Volume::shift()
 }
 
 template <class T> void
-AudioStream<T>::wipeOut()
+AudioStream<T>::alignWritePtr()
 {
-    lock();
-    this->clear(T(0,0));
-    unlock();
+    w.store((r.load() + capacity / 2) % capacity);
 }
 
 template <class T> void
-AudioStream<T>::alignWritePtr()
+AudioStream<T>::alignReadPtr()
 {
-    lock();
-    this->align(this->cap() / 2);
-    unlock();
+    r.store((w.load() + capacity / 2) % capacity);
+}
+
+template <class T> void
+AudioStream<T>::wipeOut()
+{
+    auto pos = (w.load(std::memory_order_acquire) + capacity / 2) % capacity;
+
+    for (isize i = 0; i < capacity / 2; i++) elements[(pos + i) % capacity] = T(0,0);
+    r.store(pos, std::memory_order_release);
 }
 
 template <class T> void
 AudioStream<T>::copy(void *buffer, isize n, Volume &vol)
 {
     // The caller has to ensure that no buffer underflows occurs
-    assert(this->count() >= n);
+    assert(count() >= n);
+
+    auto pos = r.load(std::memory_order_relaxed);
 
     // Quick path: Volume is stable at 0 or 1
     if (!vol.fading()) {
@@ -59,9 +66,10 @@ AudioStream<T>::copy(void *buffer, isize n, Volume &vol)
         if (vol.current == 1.0) {
 
             for (isize i = 0; i < n; i++) {
-                T sample = this->read();
+                T sample = elements[(pos + i) % capacity];
                 sample.copy(buffer, i);
             }
+            skip(n);
             return;
         }
     }
@@ -69,17 +77,20 @@ AudioStream<T>::copy(void *buffer, isize n, Volume &vol)
     // Generic path: Modulate the volume
     for (isize i = 0; i < n; i++) {
         vol.shift();
-        T sample = this->read();
+        T sample = elements[(pos + i) % capacity];
         sample.modulate(vol.current);
         sample.copy(buffer, i);
     }
+    skip(n);
 }
 
 template <class T> void
 AudioStream<T>::copy(void *buffer1, void *buffer2, isize n, Volume &vol)
 {
     // The caller has to ensure that no buffer underflows occurs
-    assert(this->count() >= n);
+    assert(count() >= n);
+
+    auto pos = r.load(std::memory_order_relaxed);
 
     // Quick path: Volume is stable at 0 or 1
     if (!vol.fading()) {
@@ -95,9 +106,10 @@ AudioStream<T>::copy(void *buffer1, void *buffer2, isize n, Volume &vol)
         if (vol.current == 1.0) {
 
             for (isize i = 0; i < n; i++) {
-                T sample = this->read();
+                T sample = elements[(pos + i) % capacity];
                 sample.copy(buffer1, buffer2, i);
             }
+            skip(n);
             return;
         }
     }
@@ -105,17 +117,19 @@ AudioStream<T>::copy(void *buffer1, void *buffer2, isize n, Volume &vol)
     // Generic path: Modulate the volume
     for (isize i = 0; i < n; i++) {
         vol.shift();
-        T sample = this->read();
+        T sample = elements[(pos + i) % capacity];
         sample.modulate(vol.current);
         sample.copy(buffer1, buffer2, i);
     }
+    skip(n);
 }
 
 template <class T> float
 AudioStream<T>::draw(u32 *buffer, isize width, isize height,
                      bool left, float highestAmplitude, u32 color) const
 {
-    isize dw = this->cap() / width;
+    isize dw = capacity / width;
+    isize pos = r.load(std::memory_order_relaxed);
     float newHighestAmplitude = 0.001f;
     
     // Clear buffer
@@ -127,7 +141,7 @@ AudioStream<T>::draw(u32 *buffer, isize width, isize height,
     for (isize w = 0; w < width; w++) {
         
         // Read samples from ringbuffer
-        T pair = this->current(w * dw);
+        T pair = elements[(pos + w * dw) % capacity];
         float sample = pair.magnitude(left);
         
         if (sample == 0) {
@@ -161,6 +175,7 @@ AudioStream<T>::draw(u32 *buffer, isize width, isize height,
 
 template void AudioStream<SAMPLE_T>::wipeOut();
 template void AudioStream<SAMPLE_T>::alignWritePtr();
+template void AudioStream<SAMPLE_T>::alignReadPtr();
 template void AudioStream<SAMPLE_T>::copy(void *, isize, Volume &);
 template void AudioStream<SAMPLE_T>::copy(void *, void *, isize, Volume &);
 template float AudioStream<SAMPLE_T>::draw(u32 *, isize, isize, bool, float, u32) const;
@@ -10,8 +10,8 @@
 #pragma once
 
 #include "Aliases.h"
-#include "Concurrency.h"
-#include "RingBuffer.h"
+#include "Types.h"
+#include <atomic>
 
 namespace vamiga {
 
@@ -22,9 +22,13 @@ namespace vamiga {
  * unit of the host machine.
  *
  * The audio stream is designes as a ring buffer, because samples are written
- * and read asynchroneously. Since reading and writing is carried out in
- * different threads, accesses to the audio stream need to be preceded by a call
- * to lock() and followed by a call to unlock().
+ * and read asynchroneously. It is a single-producer, single-consumer queue
+ * which does not require any locking. The emulator thread is the only thread
+ * writing into the stream and the only one moving the write pointer. The audio
+ * thread of the host is the only one reading from the stream and the only one
+ * moving the read pointer. Both pointers are atomic variables. Each side
+ * publishes its pointer with release semantics after it has finished
+ * accessing the element storage.
  *
  * The audio stream is designed to hold elements of a generic type to make
  * vAmiga compilable on different target platforms. E.g., the Mac version holds
@@ -135,31 +139,72 @@ struct Volume {
 // AudioStream
 //
 
-template <class T> class AudioStream : public util::RingBuffer <T, 16384> {
+template <class T> class AudioStream {
 
-    // Mutex for synchronizing read / write accesses
-    util::ReentrantMutex mutex;
+    static constexpr isize capacity = 16384;
+
+    // Element storage
+    T elements[capacity];
 
 public:
-    
-    // Locks or unlocks the mutex
-    void lock() { mutex.lock(); }
-    void unlock() { mutex.unlock(); }
 
-    // Initializes the ring buffer with zeroes
-    void wipeOut();
-    
+    // Read pointer (only modified by the consumer)
+    std::atomic<isize> r = 0;
+
+    // Write pointer (only modified by the producer)
+    std::atomic<isize> w = 0;
+
+
+    //
+    // Querying the fill status
+    //
+
+    isize cap() const { return capacity; }
+    isize count() const { return (capacity + w.load() - r.load()) % capacity; }
+    double fillLevel() const { return (double)count() / capacity; }
+    bool isEmpty() const { return r.load() == w.load(); }
+    static isize next(isize i) { return i < capacity - 1 ? i + 1 : 0; }
+
+
+    //
+    // Writing data (producer)
+    //
+
     // Adds a sample to the ring buffer
-    void add(float l, float r) { this->write(T(l,r)); }
+    void add(float l, float r) {
+
+        auto pos = w.load(std::memory_order_relaxed);
+        elements[pos] = T(l,r);
+        w.store(next(pos), std::memory_order_release);
+    }
 
     // Puts the write pointer somewhat ahead of the read pointer
     void alignWritePtr();
-    
-    
+
+
     //
-    // Copying data
+    // Reading data (consumer)
     //
-    
+
+    // Puts the read pointer somewhat behind the write pointer
+    void alignReadPtr();
+
+    /* Discards all buffered samples. The read pointer is moved half a buffer
+     * behind the write pointer and the elements in between are zeroed. Only
+     * elements the producer has already passed are touched.
+     */
+    void wipeOut();
+
+    // Returns a pointer to the next sample
+    T *currentAddr() { return &elements[r.load(std::memory_order_relaxed)]; }
+
+    // Skips a certain number of samples
+    void skip(isize n) {
+
+        auto pos = r.load(std::memory_order_relaxed);
+        r.store((pos + n) % capacity, std::memory_order_release);
+    }
+
     /* Copies n audio samples into a memory buffer. These functions mark the
      * final step in the audio pipeline. They are used to copy the generated
      * sound samples into the buffers of the native sound device. In additon
@@ -13,6 +13,7 @@
 #include "CIA.h"
 #include "IOUtils.h"
 #include "MsgQueue.h"
+#include "SSEUtils.h"
 #include <cmath>
 #include <algorithm>
 
@@ -75,6 +76,39 @@ Muxer::_dump(Category category, std::ostream& os) const
 
         os << tab("Fill level");
         os << fillLevelAsString(stream.fillLevel()) << std::endl;
+        os << tab("Bypassed");
+        os << bol(bypass) << std::endl;
+    }
+
+    if (category == Category::Stats) {
+
+        os << tab("Buffer underflows");
+        os << dec(stats.bufferUnderflows) << std::endl;
+        os << tab("Buffer overflows");
+        os << dec(stats.bufferOverflows) << std::endl;
+        os << tab("Produced samples");
+        os << dec(stats.producedSamples) << std::endl;
+        os << tab("Consumed samples");
+        os << dec(stats.consumedSamples) << std::endl;
+        os << tab("Fill level");
+        os << fillLevelAsString(100.0 * stats.fillLevel) << " (";
+        os << fillLevelAsString(100.0 * stats.minFillLevel) << " - ";
+        os << fillLevelAsString(100.0 * stats.maxFillLevel) << ")" << std::endl;
+        os << tab("Latency");
+        os << flt(stats.latency) << " msec" << std::endl;
+        os << tab("Rate adjustments");
+        os << dec(stats.rateAdjustments) << std::endl;
+        os << tab("Rate history");
+        for (isize i = 0; i < 8 && stats.rateHistory[i] != 0; i++) {
+            os << (i ? ", " : "") << flt(stats.rateHistory[i]);
+        }
+        os << std::endl;
+        os << tab("Request interval");
+        os << flt(stats.interval) << " msec" << std::endl;
+        os << tab("Jitter (50/95/99%)");
+        os << flt(stats.jitter50) << " / ";
+        os << flt(stats.jitter95) << " / ";
+        os << flt(stats.jitter99) << " msec" << std::endl;
     }
 }
 
@@ -84,7 +118,11 @@ Muxer::_reset(bool hard)
     RESET_SNAPSHOT_ITEMS(hard)
     
     stats = { };
-    
+    stats.rateHistory[0] = host.getSampleRate();
+    intervalPos = 0;
+    minCount = INT32_MAX;
+    maxCount = 0;
+
     for (isize i = 0; i < 4; i++) sampler[i].reset();
     clear();
 }
@@ -94,11 +132,8 @@ Muxer::clear()
 {
     debug(AUDBUF_DEBUG, "clear()\n");
     
-    // Wipe out the ringbuffer
-    stream.lock();
-    stream.wipeOut();
-    stream.alignWritePtr();
-    stream.unlock();
+    // Let the audio thread wipe out the ringbuffer
+    wipeOutRequested = true;
     
     // Wipe out the filter buffers
     filterL.clear();
@@ -188,6 +223,9 @@ Muxer::setConfigItem(Option option, i64 value)
             }
             
             config.samplingMethod = (SamplingMethod)value;
+
+            // Start over, because the methods manage the samplers differently
+            for (isize i = 0; i < 4; i++) sampler[i].reset();
             return;
             
         case OPT_AUDVOLL:
@@ -260,8 +298,18 @@ Muxer::setSampleRate(double hz)
 void
 Muxer::adjustSpeed()
 {
-    cyclesPerSample = double(amiga.masterClockFrequency()) / host.getSampleRate();
+    auto hz = host.getSampleRate();
+
+    cyclesPerSample = double(amiga.masterClockFrequency()) / hz;
     assert(cyclesPerSample > 0);
+
+    // Keep track of the sample rates that have actually been applied
+    if (stats.rateHistory[0] != hz) {
+
+        for (isize i = 7; i > 0; i--) stats.rateHistory[i] = stats.rateHistory[i - 1];
+        stats.rateHistory[0] = hz;
+        stats.rateAdjustments++;
+    }
 }
 
 isize
@@ -283,7 +331,8 @@ Muxer::rampUp()
 void
 Muxer::rampUpFromZero()
 {
-    volume.current = 0.0;
+    // The current volume is reset by the audio thread
+    fadeInRequested = true;
     
     rampUp();
 }
@@ -322,6 +371,11 @@ Muxer::synthesize(Cycle clock, Cycle target, long count)
             
             synthesize<SMP_LINEAR>(clock, count, cyclesPerSample);
             break;
+
+        case SMP_BLEP:
+
+            synthesize<SMP_BLEP>(clock, count, cyclesPerSample);
+            break;
             
         default:
             fatalError;
@@ -333,7 +387,10 @@ Muxer::synthesize(Cycle clock, Cycle target)
 {
     assert(target > clock);
     assert(cyclesPerSample > 0);
-    
+
+    // Skip synthesis if no samples are needed
+    if (updateBypass()) return;
+
     // Determine how many samples we need to produce
     double exact = (double)(target - clock) / cyclesPerSample + fraction;
     long count = (long)exact;
@@ -354,6 +411,11 @@ Muxer::synthesize(Cycle clock, Cycle target)
             
             synthesize<SMP_LINEAR>(clock, count, cyclesPerSample);
             break;
+
+        case SMP_BLEP:
+
+            synthesize<SMP_BLEP>(clock, count, cyclesPerSample);
+            break;
             
         default:
             fatalError;
@@ -361,53 +423,122 @@ Muxer::synthesize(Cycle clock, Cycle target)
     }
 }
 
+bool
+Muxer::updateBypass()
+{
+    auto idle = util::Time::now() - lastConsumption.load();
+
+    // Check if anybody is interested in audio samples
+    bool skip = amiga.inWarpMode() || idle.asSeconds() > 0.5;
+
+    // The screen recorder relies on the sampler contents
+    if (denise.screenRecorder.isRecording()) skip = false;
+
+    // The recording sink needs all samples
+    if (capture.isActive()) skip = false;
+
+    // So does the shared memory export
+    if (denise.frameExport.isActive()) skip = false;
+
+    if (skip != bypass) {
+
+        debug(AUDBUF_DEBUG, "Audio bypass %s\n", skip ? "on" : "off");
+        bypass = skip;
+
+        // Start over with empty samplers and a silent output stream
+        for (isize i = 0; i < 4; i++) sampler[i].reset();
+        wipeOutRequested = true;
+        fraction = 0.0;
+
+        // Fade in smoothly when audio is needed again
+        if (!bypass) rampUpFromZero();
+    }
+
+    return bypass;
+}
+
 template <SamplingMethod method> void
 Muxer::synthesize(Cycle clock, long count, double cyclesPerSample)
 {
     assert(count > 0);
 
-    stream.lock();
-    
-    // Check for a buffer overflow
-    if (stream.count() + count >= stream.cap()) handleBufferOverflow();
+    // Apply a pending sample rate adjustment
+    if (auto hz = requestedSampleRate.exchange(0)) setSampleRate(double(hz));
+
+    // Grow the scratch buffers if necessary
+    if (isize(lBuffer.size()) < count) {
+
+        for (isize c = 0; c < 4; c++) chBuffer[c].resize(count);
+        lBuffer.resize(count);
+        rBuffer.resize(count);
+    }
+
+    // Interpolate each channel separately
+    for (isize c = 0; c < 4; c++) {
+
+        float *buffer = chBuffer[c].data();
+
+        if constexpr (method == SMP_BLEP) {
+
+            sampler[c].resample(clock, cyclesPerSample, buffer, count);
+
+        } else {
+
+            double cycle = (double)clock;
+
+            for (long i = 0; i < count; i++) {
+
+                buffer[i] = (float)sampler[c].interpolate <method> ((Cycle)cycle);
+                cycle += cyclesPerSample;
+            }
+        }
+    }
+
+    // Compute the channel weights for the left and the right output
+    float wl[4], wr[4];
+    for (isize c = 0; c < 4; c++) {
+
+        wl[c] = vol[c] * (1 - pan[c]);
+        wr[c] = vol[c] * pan[c];
+    }
+
+    // Mix all channels
+    const float *ch[4] = {
 
-    double cycle = (double)clock;
+        chBuffer[0].data(), chBuffer[1].data(), chBuffer[2].data(), chBuffer[3].data()
+    };
+    util::mix(ch, wl, wr, lBuffer.data(), rBuffer.data(), count);
+
+    // Apply audio filter
     bool doFilterL = filterL.isEnabled();
     bool doFilterR = filterR.isEnabled();
 
+    if (doFilterL && doFilterR) {
+        AudioFilter::apply(filterL, filterR, lBuffer.data(), rBuffer.data(), count);
+    } else {
+        if (doFilterL) filterL.apply(lBuffer.data(), count);
+        if (doFilterR) filterR.apply(rBuffer.data(), count);
+    }
+
+    // Apply master volume
     for (long i = 0; i < count; i++) {
 
-        float ch0 = sampler[0].interpolate <method> ((Cycle)cycle) * vol[0];
-        float ch1 = sampler[1].interpolate <method> ((Cycle)cycle) * vol[1];
-        float ch2 = sampler[2].interpolate <method> ((Cycle)cycle) * vol[2];
-        float ch3 = sampler[3].interpolate <method> ((Cycle)cycle) * vol[3];
-        
-        // Compute left channel output
-        float l =
-        ch0 * (1 - pan[0]) + ch1 * (1 - pan[1]) +
-        ch2 * (1 - pan[2]) + ch3 * (1 - pan[3]);
-
-        // Compute right channel output
-        float r =
-        ch0 * pan[0] + ch1 * pan[1] +
-        ch2 * pan[2] + ch3 * pan[3];
-
-        // Apply audio filter
-        if (doFilterL) l = filterL.apply(l);
-        if (doFilterR) r = filterR.apply(r);
-        
-        // Apply master volume
-        l *= volL;
-        r *= volR;
-        
-        // Write sample into ringbuffer
-        stream.add(l, r);
-        stats.producedSamples++;
-        
-        cycle += cyclesPerSample;
+        lBuffer[i] *= volL;
+        rBuffer[i] *= volR;
     }
-    
-    stream.unlock();
+
+    // Feed the recording sink
+    if (capture.isActive()) capture.add(lBuffer.data(), rBuffer.data(), count);
+
+    // Feed the shared memory export (the recorder's muxer is not exported)
+    if (this == &paula.muxer) denise.frameExport.addAudio(lBuffer.data(), rBuffer.data(), count);
+
+    // Check for a buffer overflow
+    if (stream.count() + count >= stream.cap()) handleBufferOverflow();
+
+    // Write the samples into the ringbuffer
+    for (long i = 0; i < count; i++) stream.add(lBuffer[i], rBuffer[i]);
+    stats.producedSamples += count;
 }
 
 void
@@ -418,23 +549,23 @@ Muxer::handleBufferUnderflow()
     // (1) The consumer runs slightly faster than the producer
     // (2) The producer is halted or not startet yet
     
-    debug(AUDBUF_DEBUG, "UNDERFLOW (r: %ld w: %ld)\n", stream.r, stream.w);
+    debug(AUDBUF_DEBUG, "UNDERFLOW (r: %ld w: %ld)\n", stream.r.load(), stream.w.load());
     
-    // Reset the write pointer
-    stream.alignWritePtr();
+    // Reset the read pointer (this function is called by the consumer)
+    stream.alignReadPtr();
 
     // Determine the elapsed seconds since the last pointer adjustment
-    auto elapsedTime = util::Time::now() - lastAlignment;
-    lastAlignment = util::Time::now();
+    auto now = util::Time::now();
+    auto elapsedTime = now - lastAlignment.exchange(now);
     
-    // Adjust the sample rate, if condition (1) holds
-    if (elapsedTime.asSeconds() > 10.0) {
+    // Adjust the sample rate, if condition (1) holds (unless recording)
+    if (elapsedTime.asSeconds() > 10.0 && !capture.isActive()) {
 
         stats.bufferUnderflows++;
         
         // Increase the sample rate based on what we've measured
         auto offPerSec = (stream.cap() / 2) / elapsedTime.asSeconds();
-        setSampleRate(host.getSampleRate() + (isize)offPerSec);
+        requestedSampleRate = isize(host.getSampleRate()) + (isize)offPerSec;
     }
 }
 
@@ -446,17 +577,17 @@ Muxer::handleBufferOverflow()
     // (1) The consumer runs slightly slower than the producer
     // (2) The consumer is halted or not startet yet
     
-    debug(AUDBUF_DEBUG, "OVERFLOW (r: %ld w: %ld)\n", stream.r, stream.w);
+    debug(AUDBUF_DEBUG, "OVERFLOW (r: %ld w: %ld)\n", stream.r.load(), stream.w.load());
     
-    // Reset the write pointer
+    // Reset the write pointer (this function is called by the producer)
     stream.alignWritePtr();
 
     // Determine the number of elapsed seconds since the last adjustment
-    auto elapsedTime = util::Time::now() - lastAlignment;
-    lastAlignment = util::Time::now();
+    auto now = util::Time::now();
+    auto elapsedTime = now - lastAlignment.exchange(now);
     
-    // Adjust the sample rate, if condition (1) holds
-    if (elapsedTime.asSeconds() > 10.0) {
+    // Adjust the sample rate, if condition (1) holds (unless recording)
+    if (elapsedTime.asSeconds() > 10.0 && !capture.isActive()) {
         
         stats.bufferOverflows++;
         
@@ -466,53 +597,116 @@ Muxer::handleBufferOverflow()
     }
 }
 
+void
+Muxer::applyRequests()
+{
+    if (wipeOutRequested.exchange(false)) stream.wipeOut();
+    if (fadeInRequested.exchange(false)) volume.current = 0.0;
+}
+
 void
 Muxer::ignoreNextUnderOrOverflow()
 {
-    lastAlignment = util::Time::now();
+    lastAlignment.store(util::Time::now());
 }
 
 void
 Muxer::copy(void *buffer, isize n)
 {
-    stream.lock();
-    
+    // Apply pending requests of the emulator thread
+    applyRequests();
+
     // Check for a buffer underflow
     if (stream.count() < n) handleBufferUnderflow();
-    
+    recordConsumption(n, stream.count());
+
     // Copy sound samples
     stream.copy(buffer, n, volume);
-    stats.consumedSamples += n;
-    
-    stream.unlock();
 }
 
 void
 Muxer::copy(void *buffer1, void *buffer2, isize n)
 {
-    stream.lock();
-    
+    // Apply pending requests of the emulator thread
+    applyRequests();
+
     // Check for a buffer underflow
     if (stream.count() < n) handleBufferUnderflow();
-    
+    recordConsumption(n, stream.count());
+
     // Copy sound samples
     stream.copy(buffer1, buffer2, n, volume);
+}
+
+void
+Muxer::recordConsumption(isize n, isize count)
+{
+    auto now = util::Time::now();
+    auto elapsed = now - lastConsumption.exchange(now);
+
     stats.consumedSamples += n;
 
-    stream.unlock();
+    // Record the time span since the last request (unless we've been idle)
+    if (elapsed.asSeconds() < 0.5) {
+
+        auto pos = intervalPos.load();
+        intervals[pos % intervalCount] = float(elapsed.asMicroseconds() / 1000.0);
+        intervalPos = pos + 1;
+    }
+
+    // Keep track of the lowest and highest number of buffered samples
+    if (count - n < minCount) minCount = std::max(count - n, isize(0));
+    if (count > maxCount) maxCount = count;
+}
+
+void
+Muxer::updateStats()
+{
+    auto count = stream.count();
+    auto rate = host.getSampleRate();
+
+    // Determine the current fill level and the extreme values seen so far
+    stats.fillLevel = stream.fillLevel();
+    stats.minFillLevel = double(std::min(minCount.load(), count)) / stream.cap();
+    stats.maxFillLevel = double(std::max(maxCount.load(), count)) / stream.cap();
+
+    // Compute how long a newly written sample stays in the stream
+    stats.latency = rate > 0 ? 1000.0 * count / rate : 0.0;
+
+    // Analyze the most recent request intervals
+    if (isize n = std::min(intervalPos.load(), intervalCount); n > 0) {
+
+        float values[intervalCount];
+        double sum = 0.0;
+
+        for (isize i = 0; i < n; i++) sum += (values[i] = intervals[i]);
+        stats.interval = sum / n;
+
+        std::sort(values, values + n);
+        auto median = values[n / 2];
+
+        for (isize i = 0; i < n; i++) values[i] = std::abs(values[i] - median);
+        std::sort(values, values + n);
+
+        stats.jitter50 = values[n * 50 / 100];
+        stats.jitter95 = values[n * 95 / 100];
+        stats.jitter99 = values[n * 99 / 100];
+    }
 }
 
 SAMPLE_T *
 Muxer::nocopy(isize n)
 {
-    stream.lock();
-    
+    // Apply pending requests of the emulator thread
+    applyRequests();
+
+    // Check for a buffer underflow
     if (stream.count() < n) handleBufferUnderflow();
+    recordConsumption(n, stream.count());
+
     SAMPLE_T *addr = stream.currentAddr();
     stream.skip(n);
-    stats.consumedSamples += n;
 
-    stream.unlock();
     return addr;
 }
 
@@ -12,6 +12,7 @@
 #include "MuxerTypes.h"
 
 #include "SubComponent.h"
+#include "AudioCapture.h"
 #include "AudioStream.h"
 #include "AudioFilter.h"
 #include "Chrono.h"
@@ -48,7 +49,7 @@ class Muxer : public SubComponent {
     // Current configuration
     MuxerConfig config = {};
     
-    // Underflow and overflow counters
+    // Buffer statistics
     MuxerStats stats = {};
     
     // Master clock cycles per audio sample
@@ -57,8 +58,30 @@ class Muxer : public SubComponent {
     // Fraction of a sample that hadn't been generated in synthesize
     double fraction = 0.0;
 
-    // Time stamp of the last write pointer alignment
-    util::Time lastAlignment;
+    // Time stamp of the last read or write pointer alignment
+    std::atomic<util::Time> lastAlignment;
+
+    // Sample rate adjustment requested by the audio thread
+    std::atomic<isize> requestedSampleRate = 0;
+
+    // Time stamp of the most recent read access of the audio thread
+    std::atomic<util::Time> lastConsumption;
+
+    // Time spans between the most recent read accesses (in msec)
+    static constexpr isize intervalCount = 256;
+    std::atomic<float> intervals[intervalCount];
+    std::atomic<isize> intervalPos = 0;
+
+    // Lowest and highest number of buffered samples seen by the audio thread
+    std::atomic<isize> minCount = INT32_MAX;
+    std::atomic<isize> maxCount = 0;
+
+    // Indicates whether audio synthesis is currently skipped
+    bool bypass = false;
+
+    // Requests handed over to the audio thread (applied before reading)
+    std::atomic<bool> wipeOutRequested = false;
+    std::atomic<bool> fadeInRequested = false;
 
     // Volume control
     Volume volume;
@@ -70,6 +93,11 @@ class Muxer : public SubComponent {
 
     // Panning factors
     float pan[4];
+
+    // Scratch buffers used by synthesize (one per channel, left, right)
+    std::vector<float> chBuffer[4];
+    std::vector<float> lBuffer;
+    std::vector<float> rBuffer;
     
     
     //
@@ -89,6 +117,9 @@ public:
 
     // Output
     AudioStream<SAMPLE_T> stream;
+
+    // Optional recording sink (fed with the same samples as the stream)
+    AudioCapture capture;
     
     // Audio filters
     AudioFilter filterL = AudioFilter(amiga);
@@ -184,9 +215,22 @@ public:
     // Returns information about the gathered statistical information
     const MuxerStats &getStats() const { return stats; }
 
+    // Updates the buffer statistics (called once per frame)
+    void updateStats();
+
+private:
+
+    // Records a read access of the audio thread
+    void recordConsumption(isize n, isize count);
+
+public:
+
     // Returns true if the output volume is zero
     bool isMuted() const { return config.volL == 0 && config.volR == 0; }
 
+    // Returns true if the samplers and the output stream are not fed
+    bool isBypassed() const { return bypass; }
+
 
     //
     // Controlling volume
@@ -219,10 +263,20 @@ private:
 
     template <SamplingMethod method>
     void synthesize(Cycle clock, long count, double cyclesPerSample);
+
+    /* Decides whether audio synthesis can be skipped. This is the case in warp
+     * mode and if the audio thread hasn't requested samples for a while. In
+     * this mode, the state machines keep running, but they no longer feed the
+     * samplers and no samples are mixed.
+     */
+    bool updateBypass();
     
     // Handles a buffer underflow or overflow condition
     void handleBufferUnderflow();
     void handleBufferOverflow();
+
+    // Carries out the requests of the emulator thread (called by the consumer)
+    void applyRequests();
     
 public:
     
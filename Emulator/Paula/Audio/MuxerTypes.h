@@ -34,10 +34,32 @@ MuxerConfig;
 
 typedef struct
 {
+    // Buffer exceptions
     isize bufferUnderflows;
     isize bufferOverflows;
+
+    // Sample counters
     i64 producedSamples;
     i64 consumedSamples;
+
+    // Current, lowest, and highest fill level of the audio stream
     double fillLevel;
+    double minFillLevel;
+    double maxFillLevel;
+
+    // Time a sample stays in the audio stream (in msec)
+    double latency;
+
+    // Changes of the effective sample rate (most recent first)
+    isize rateAdjustments;
+    double rateHistory[8];
+
+    // Average time between two consumer requests (in msec)
+    double interval;
+
+    // Deviation of the request intervals from the median (percentiles in msec)
+    double jitter50;
+    double jitter95;
+    double jitter99;
 }
 MuxerStats;
@@ -9,6 +9,14 @@
 
 #include "config.h"
 #include "Sampler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif
 
 namespace vamiga {
 
@@ -20,6 +28,10 @@ Sampler::reset()
 
     // Add a dummy element to ensure the buffer is not empty
     append(0,0);
+
+    // Discard all pending residuals
+    std::memset(blepBuffer, 0, sizeof(blepBuffer));
+    blepPos = 0;
 }
 
 template <SamplingMethod method> i16
@@ -75,6 +87,110 @@ Sampler::interpolate(Cycle clock)
     }
 }
 
+/* Returns the residual table of the band-limited step. Row p contains the
+ * difference between the band-limited step and the ideal step for a step
+ * located (blepHalfWidth - 1 + p / blepPhases) samples ahead of the first tap.
+ */
+static const float *
+blepTable()
+{
+    static const std::vector<float> table = [] {
+
+        constexpr isize H = Sampler::blepHalfWidth;
+        constexpr isize N = Sampler::blepTaps;
+        constexpr isize P = Sampler::blepPhases;
+
+        // Resolution of the integration grid (points per output sample)
+        constexpr isize G = 4 * P;
+
+        // Cutoff frequency relative to the output sample rate
+        constexpr double fc = 0.45;
+
+        // Integrate a Blackman-windowed sinc over [-H, H]
+        std::vector<double> step(2 * H * G + 1);
+        double sum = 0.0, prev = 0.0;
+
+        for (isize k = 0; k < isize(step.size()); k++) {
+
+            double x = double(k) / G - H;
+            double y = 2 * fc * x;
+            double sinc = y == 0.0 ? 1.0 : sin(M_PI * y) / (M_PI * y);
+            double window = 0.42 + 0.5 * cos(M_PI * x / H) + 0.08 * cos(2 * M_PI * x / H);
+            double h = 2 * fc * sinc * window;
+
+            if (k) sum += (prev + h) / (2 * G);
+            step[k] = sum;
+            prev = h;
+        }
+
+        // Subtract the ideal step and normalize
+        std::vector<float> result(P * N);
+        for (isize p = 0; p < P; p++) {
+            for (isize i = 0; i < N; i++) {
+
+                // Grid index of x = i - (H - 1) - p / P
+                isize k = (i + 1) * G - 4 * p;
+                result[p * N + i] = float(step[k] / sum - 1.0);
+            }
+        }
+        return result;
+    }();
+
+    return table.data();
+}
+
+void
+Sampler::resample(Cycle clock, double cyclesPerSample, float *dst, isize count)
+{
+    assert(!isEmpty());
+
+    const float *table = blepTable();
+    double cycle = (double)clock;
+    double lookahead = blepHalfWidth * cyclesPerSample;
+    double scale = 1.0 / cyclesPerSample;
+
+    for (isize j = 0; j < count; j++, cycle += cyclesPerSample) {
+
+        // Process all steps that start influencing the current sample
+        for (isize r2 = next(r); r2 != w && keys[r2] < cycle + lookahead; r2 = next(r)) {
+
+            float delta = float(elements[r2] - elements[r]);
+            skip();
+
+            if (delta == 0) continue;
+
+            // Determine the sub-sample position of the step
+            double offset = (double(keys[r2]) - cycle) * scale - (blepHalfWidth - 1);
+            isize phase = std::clamp(isize(offset * blepPhases), isize(0), blepPhases - 1);
+            const float *row = table + phase * blepTaps;
+            float *acc = blepBuffer + blepPos;
+
+            // Add the residual of the band-limited step
+#ifdef __SSE__
+            __m128 d = _mm_set1_ps(delta);
+            for (isize i = 0; i < blepTaps; i += 4) {
+                __m128 sum = _mm_add_ps(_mm_loadu_ps(acc + i), _mm_mul_ps(d, _mm_loadu_ps(row + i)));
+                _mm_storeu_ps(acc + i, sum);
+            }
+#else
+            for (isize i = 0; i < blepTaps; i++) acc[i] += delta * row[i];
+#endif
+        }
+
+        // The current level already contains all processed steps
+        dst[j] = float(elements[r]) + blepBuffer[blepPos];
+        blepBuffer[blepPos] = 0.0f;
+
+        // Move on to the next sample
+        if (++blepPos == blepTaps) {
+
+            std::memcpy(blepBuffer, blepBuffer + blepTaps, sizeof(float) * blepTaps);
+            std::memset(blepBuffer + blepTaps, 0, sizeof(float) * blepTaps);
+            blepPos = 0;
+        }
+    }
+}
+
 template i16 Sampler::interpolate<SMP_NONE>(Cycle clock);
 template i16 Sampler::interpolate<SMP_NEAREST>(Cycle clock);
 template i16 Sampler::interpolate<SMP_LINEAR>(Cycle clock);
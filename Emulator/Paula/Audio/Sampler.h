@@ -24,12 +24,37 @@ namespace vamiga {
  */
 
 struct Sampler : util::SortedRingBuffer <i16, VPOS_CNT * HPOS_CNT_PAL> {
-    
+
+    // Half width of a band-limited step, measured in output samples
+    static constexpr isize blepHalfWidth = 8;
+
+    // Number of output samples affected by a band-limited step
+    static constexpr isize blepTaps = 2 * blepHalfWidth;
+
+    // Number of precomputed sub-sample positions
+    static constexpr isize blepPhases = 512;
+
+    // Pending residuals of all band-limited steps (used by SMP_BLEP)
+    float blepBuffer[2 * blepTaps] = { };
+
+    // Position of the next output sample in the residual buffer
+    isize blepPos = 0;
+
     // Initializes the ring buffer with a single dummy element
     void reset();
 
     // Interpolates a sound sample for the specified target cycle
     template <SamplingMethod method> i16 interpolate(Cycle clock);
+
+    /* Resamples the output signal with band-limited steps. Paula holds each
+     * sample value until the next one arrives, which makes the output signal a
+     * step function. Each step is replaced by a windowed-sinc step that is
+     * read from a precomputed polyphase table. Since a step influences output
+     * samples on both sides, the function looks ahead blepHalfWidth samples
+     * into the future. All entries up to this point must be present in the
+     * ring buffer.
+     */
+    void resample(Cycle clock, double cyclesPerSample, float *dst, isize count);
 };
 
 }
@@ -20,7 +20,8 @@ enum_long(SMP_METHOD)
 {
     SMP_NONE,
     SMP_NEAREST,
-    SMP_LINEAR
+    SMP_LINEAR,
+    SMP_BLEP
 };
 typedef SMP_METHOD SamplingMethod;
 
@@ -28,7 +29,7 @@ typedef SMP_METHOD SamplingMethod;
 struct SamplingMethodEnum : util::Reflection<SamplingMethodEnum, SamplingMethod>
 {
     static constexpr long minVal = 0;
-    static constexpr long maxVal = SMP_LINEAR;
+    static constexpr long maxVal = SMP_BLEP;
     static bool isValid(auto val) { return val >= minVal && val <= maxVal; }
 
     static const char *prefix() { return "SMP"; }
@@ -39,6 +40,7 @@ struct SamplingMethodEnum : util::Reflection<SamplingMethodEnum, SamplingMethod>
             case SMP_NONE:     return "NONE";
             case SMP_NEAREST:  return "NEAREST";
             case SMP_LINEAR:   return "LINEAR";
+            case SMP_BLEP:     return "BLEP";
         }
         return "???";
     }
@@ -28,7 +28,7 @@ StateMachine<nr>::_dump(Category category, std::ostream& os) const
     if (category == Category::Inspection) {
 
         os << tab("State machine") << dec(nr) << std::endl;
-        os << tab("State") << dec(state) << std::endl;
+        os << tab("State") << dec(currentState()) << std::endl;
         os << tab("AUDxIP") << bol(AUDxIP()) << std::endl;
         os << tab("AUDxON") << bol(AUDxON()) << std::endl;
     }
@@ -54,7 +54,7 @@ StateMachine<nr>::_inspect() const
 {
     {   SYNCHRONIZED
         
-        info.state = state;
+        info.state = currentState();
         info.dma = AUDxON();
         info.audlenLatch = audlenLatch;
         info.audlen = audlen;
@@ -71,6 +71,8 @@ StateMachine<nr>::enableDMA()
 {
     trace(AUD_DEBUG, "Enable DMA\n");
 
+    sync<ACCESSOR_AGNUS>();
+
     switch (state) {
 
         case 0b000:
@@ -85,6 +87,8 @@ StateMachine<nr>::disableDMA()
 {
     trace(AUD_DEBUG, "Disable DMA\n");
 
+    sync<ACCESSOR_AGNUS>();
+
     switch (state) {
 
         case 0b001:
@@ -99,6 +103,76 @@ StateMachine<nr>::disableDMA()
     }
 }
 
+template <isize nr> void
+StateMachine<nr>::requestDMA()
+{
+    sync<ACCESSOR_AGNUS>();
+
+    if (audDR) {
+
+        agnus.setAudxDR<nr>();
+        audDR = false;
+    }
+}
+
+template <isize nr> isize
+StateMachine<nr>::currentState() const
+{
+    if (!spinning) return state;
+
+    // Each skipped transition toggles between states 010 and 011
+    auto skipped = (agnus.clock - spinClock) / period();
+    return (skipped & 1) ? (state ^ 0b001) : state;
+}
+
+template <isize nr> bool
+StateMachine<nr>::canSpin() const
+{
+    // Only DMA mode without attachments is considered
+    if (!AUDxON() || AUDxAP() || AUDxAV()) return false;
+
+    // All samples of the current data word must have been played
+    if (enablePenhi || enablePenlo) return false;
+
+    // Pending interrupts or DMA requests must not be triggered again
+    if (intreq2 || !audDR) return false;
+
+    // Reloading the output buffer and the volume must not change anything
+    return buffer == auddat && audvol == audvolLatch;
+}
+
+template <isize nr> void
+StateMachine<nr>::fastForward(Cycle until)
+{
+    assert(spinning);
+
+    if (until <= spinClock) return;
+
+    auto skipped = (until - spinClock) / period();
+
+    if (skipped & 1) state ^= 0b001;
+    spinClock += skipped * period();
+}
+
+template <isize nr> template <Accessor s> void
+StateMachine<nr>::sync()
+{
+    if (!spinning) return;
+
+    /* CPU accesses take place after all events of the current cycle have
+     * been processed. All other accesses are performed by Agnus inside the
+     * event loop, before the audio slots are serviced.
+     */
+    fastForward(s == ACCESSOR_CPU ? agnus.clock : agnus.clock - 1);
+    spinning = false;
+
+    // Schedule the next transition as usual
+    constexpr EventSlot slot = (EventSlot)(SLOT_CH0 + nr);
+    agnus.scheduleAbs<slot>(spinClock + period(), CHX_PERFIN);
+
+    trace(AUD_DEBUG, "sync: state = %ld\n", state);
+}
+
 template <isize nr> bool
 StateMachine<nr>::AUDxIP() const 
 {
@@ -132,9 +206,9 @@ StateMachine<nr>::pbufld1()
 {
     if (!AUDxAV()) { buffer = auddat; return; }
     
-    if constexpr (nr == 0) paula.channel1.pokeAUDxVOL(auddat);
-    if constexpr (nr == 1) paula.channel2.pokeAUDxVOL(auddat);
-    if constexpr (nr == 2) paula.channel3.pokeAUDxVOL(auddat);
+    if constexpr (nr == 0) paula.channel1.pokeAUDxVOL<ACCESSOR_AGNUS>(auddat);
+    if constexpr (nr == 1) paula.channel2.pokeAUDxVOL<ACCESSOR_AGNUS>(auddat);
+    if constexpr (nr == 2) paula.channel3.pokeAUDxVOL<ACCESSOR_AGNUS>(auddat);
 }
 
 template <isize nr> void
@@ -142,9 +216,9 @@ StateMachine<nr>::pbufld2()
 {
     assert(AUDxAP());
     
-    if constexpr (nr == 0) paula.channel1.pokeAUDxPER(auddat);
-    if constexpr (nr == 1) paula.channel2.pokeAUDxPER(auddat);
-    if constexpr (nr == 2) paula.channel3.pokeAUDxPER(auddat);
+    if constexpr (nr == 0) paula.channel1.pokeAUDxPER<ACCESSOR_AGNUS>(auddat);
+    if constexpr (nr == 1) paula.channel2.pokeAUDxPER<ACCESSOR_AGNUS>(auddat);
+    if constexpr (nr == 2) paula.channel3.pokeAUDxPER<ACCESSOR_AGNUS>(auddat);
 }
 
 template <isize nr> bool
@@ -171,10 +245,14 @@ StateMachine<nr>::penhi()
     
     trace(AUD_DEBUG, "penhi: %d %d\n", sample, scaled);
 
-    if (!sampler.isFull()) {
-        sampler.append(agnus.clock, scaled);
-    } else {
-        warn("penhi: Sample buffer is full\n");
+    // Record the sample unless audio synthesis is bypassed
+    if (!paula.muxer.isBypassed()) {
+
+        if (!sampler.isFull()) {
+            sampler.append(agnus.clock, scaled);
+        } else {
+            warn("penhi: Sample buffer is full\n");
+        }
     }
     
     enablePenhi = false;
@@ -192,10 +270,14 @@ StateMachine<nr>::penlo()
 
     trace(AUD_DEBUG, "penlo: %d %d\n", sample, scaled);
 
-    if (!sampler.isFull()) {
-        sampler.append(agnus.clock, scaled);
-    } else {
-        warn("penlo: Sample buffer is full\n");
+    // Record the sample unless audio synthesis is bypassed
+    if (!paula.muxer.isBypassed()) {
+
+        if (!sampler.isFull()) {
+            sampler.append(agnus.clock, scaled);
+        } else {
+            warn("penlo: Sample buffer is full\n");
+        }
     }
     
     enablePenlo = false;
@@ -389,6 +471,36 @@ template bool StateMachine<1>::AUDxON() const;
 template bool StateMachine<2>::AUDxON() const;
 template bool StateMachine<3>::AUDxON() const;
 
+template void StateMachine<0>::requestDMA();
+template void StateMachine<1>::requestDMA();
+template void StateMachine<2>::requestDMA();
+template void StateMachine<3>::requestDMA();
+
+template isize StateMachine<0>::currentState() const;
+template isize StateMachine<1>::currentState() const;
+template isize StateMachine<2>::currentState() const;
+template isize StateMachine<3>::currentState() const;
+
+template void StateMachine<0>::sync<ACCESSOR_CPU>();
+template void StateMachine<1>::sync<ACCESSOR_CPU>();
+template void StateMachine<2>::sync<ACCESSOR_CPU>();
+template void StateMachine<3>::sync<ACCESSOR_CPU>();
+
+template void StateMachine<0>::sync<ACCESSOR_AGNUS>();
+template void StateMachine<1>::sync<ACCESSOR_AGNUS>();
+template void StateMachine<2>::sync<ACCESSOR_AGNUS>();
+template void StateMachine<3>::sync<ACCESSOR_AGNUS>();
+
+template bool StateMachine<0>::canSpin() const;
+template bool StateMachine<1>::canSpin() const;
+template bool StateMachine<2>::canSpin() const;
+template bool StateMachine<3>::canSpin() const;
+
+template void StateMachine<0>::fastForward(Cycle until);
+template void StateMachine<1>::fastForward(Cycle until);
+template void StateMachine<2>::fastForward(Cycle until);
+template void StateMachine<3>::fastForward(Cycle until);
+
 template void StateMachine<0>::move_000_010();
 template void StateMachine<1>::move_000_010();
 template void StateMachine<2>::move_000_010();
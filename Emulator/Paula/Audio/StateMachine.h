@@ -74,6 +74,17 @@ public:
     bool enablePenlo = false;
     bool enablePenhi = false;
 
+    /* Fast-forward mode. If the period is short and all samples of the
+     * current data word have been played, the state machine keeps toggling
+     * between states 010 and 011 without any observable effect until new data
+     * arrives or a register changes. In this case, the transitions are no
+     * longer scheduled one by one. Instead, spinClock marks the last executed
+     * transition and all others are derived arithmetically when the state
+     * machine gets synchronized.
+     */
+    bool spinning = false;
+    Cycle spinClock = 0;
+
     
     //
     // Initializing
@@ -134,7 +145,9 @@ private:
         << audDR
         << intreq2
         << enablePenlo
-        << enablePenhi;
+        << enablePenhi
+        << spinning
+        << spinClock;
     }
 
     isize _size() override { COMPUTE_SNAPSHOT_SIZE }
@@ -214,7 +227,34 @@ public:
     void penlo();
 
     // Transfers a DMA request to Agnus (done in the first refresh cycle)
-    void requestDMA() { if (audDR) { agnus.setAudxDR<nr>(); audDR = 0; } }
+    void requestDMA();
+
+
+    //
+    // Fast-forwarding
+    //
+
+public:
+
+    // Returns the number of master cycles between two transitions
+    Cycle period() const { return DMA_CYCLES(audperLatch == 0 ? 0x10000 : audperLatch); }
+
+    // Returns the time span between two wakeup calls in fast-forward mode
+    Cycle wakeupDelay() const { return period() * std::max(Cycle(1), DMA_CYCLES(HPOS_CNT_PAL) / period()); }
+
+    // Returns the state the machine is in (taking fast-forward mode into account)
+    isize currentState() const;
+
+    // Catches up with all skipped transitions and leaves fast-forward mode
+    template <Accessor s> void sync();
+
+private:
+
+    // Checks if the next transitions can be skipped
+    bool canSpin() const;
+
+    // Performs all skipped transitions up to (and including) the given cycle
+    void fastForward(Cycle until);
     
     
     //
@@ -242,9 +282,9 @@ public:
 
     // Writes a value into an audio register
     void pokeAUDxLEN(u16 value);
-    void pokeAUDxPER(u16 value);
-    void pokeAUDxVOL(u16 value);
-    void pokeAUDxDAT(u16 value);
+    template <Accessor s> void pokeAUDxPER(u16 value);
+    template <Accessor s> void pokeAUDxVOL(u16 value);
+    template <Accessor s> void pokeAUDxDAT(u16 value);
 
     
     //
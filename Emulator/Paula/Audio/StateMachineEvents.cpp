@@ -17,6 +17,16 @@ StateMachine<nr>::serviceEvent()
 {
     assert(agnus.id[SLOT_CH0+nr] == CHX_PERFIN);
 
+    constexpr EventSlot slot = (EventSlot)(SLOT_CH0 + nr);
+
+    // Skip all transitions since the last wakeup call in fast-forward mode
+    if (spinning) {
+
+        fastForward(agnus.clock);
+        agnus.scheduleAbs<slot>(spinClock + wakeupDelay(), CHX_PERFIN);
+        return;
+    }
+
     trace(AUD_DEBUG, "CHX_PERFIN state = %ld\n", state);
 
     switch (state) {
@@ -24,16 +34,31 @@ StateMachine<nr>::serviceEvent()
         case 0b010:
 
             move_010_011();
-            return;
+            break;
 
         case 0b011:
 
-            (AUDxON() || !AUDxIP()) ? move_011_010() : move_011_000();
-            return;
+            if (AUDxON() || !AUDxIP()) {
+                move_011_010();
+            } else {
+                move_011_000();
+                return;
+            }
+            break;
 
         default:
             fatalError;
     }
+
+    // Enter fast-forward mode if the upcoming transitions have no effect
+    if (wakeupDelay() > period() && canSpin()) {
+
+        trace(AUD_DEBUG, "Entering fast-forward mode\n");
+
+        spinning = true;
+        spinClock = agnus.clock;
+        agnus.scheduleAbs<slot>(spinClock + wakeupDelay(), CHX_PERFIN);
+    }
 }
 
 template void StateMachine<0>::serviceEvent();
@@ -20,29 +20,33 @@ StateMachine<nr>::pokeAUDxLEN(u16 value)
     audlenLatch = value;
 }
 
-template <isize nr> void
+template <isize nr> template <Accessor s> void
 StateMachine<nr>::pokeAUDxPER(u16 value)
 {
     trace(AUDREG_DEBUG, "pokeAUD%ldPER(%X)\n", nr, value);
     
+    sync<s>();
     audperLatch = value;
 }
 
-template <isize nr> void
+template <isize nr> template <Accessor s> void
 StateMachine<nr>::pokeAUDxVOL(u16 value)
 {
     trace(AUDREG_DEBUG, "pokeAUD%ldVOL(%X)\n", nr, value);
 
+    sync<s>();
+
     // 1. Only the lowest 7 bits are evaluated
     // 2. All values greater than 64 are treated as 64 (max volume)
     audvolLatch = (u16)std::min(value & 0x7F, 64);
 }
 
-template <isize nr> void
+template <isize nr> template <Accessor s> void
 StateMachine<nr>::pokeAUDxDAT(u16 value)
 {
     trace(AUDREG_DEBUG, "pokeAUD%ldDAT(%X)\n", nr, value);
     
+    sync<s>();
     auddat = value;
     enablePenlo = enablePenhi = true;
     
@@ -97,19 +101,31 @@ template void StateMachine<1>::pokeAUDxLEN(u16 value);
 template void StateMachine<2>::pokeAUDxLEN(u16 value);
 template void StateMachine<3>::pokeAUDxLEN(u16 value);
 
-template void StateMachine<0>::pokeAUDxPER(u16 value);
-template void StateMachine<1>::pokeAUDxPER(u16 value);
-template void StateMachine<2>::pokeAUDxPER(u16 value);
-template void StateMachine<3>::pokeAUDxPER(u16 value);
+template void StateMachine<0>::pokeAUDxPER<ACCESSOR_CPU>(u16 value);
+template void StateMachine<0>::pokeAUDxPER<ACCESSOR_AGNUS>(u16 value);
+template void StateMachine<1>::pokeAUDxPER<ACCESSOR_CPU>(u16 value);
+template void StateMachine<1>::pokeAUDxPER<ACCESSOR_AGNUS>(u16 value);
+template void StateMachine<2>::pokeAUDxPER<ACCESSOR_CPU>(u16 value);
+template void StateMachine<2>::pokeAUDxPER<ACCESSOR_AGNUS>(u16 value);
+template void StateMachine<3>::pokeAUDxPER<ACCESSOR_CPU>(u16 value);
+template void StateMachine<3>::pokeAUDxPER<ACCESSOR_AGNUS>(u16 value);
 
-template void StateMachine<0>::pokeAUDxVOL(u16 value);
-template void StateMachine<1>::pokeAUDxVOL(u16 value);
-template void StateMachine<2>::pokeAUDxVOL(u16 value);
-template void StateMachine<3>::pokeAUDxVOL(u16 value);
+template void StateMachine<0>::pokeAUDxVOL<ACCESSOR_CPU>(u16 value);
+template void StateMachine<0>::pokeAUDxVOL<ACCESSOR_AGNUS>(u16 value);
+template void StateMachine<1>::pokeAUDxVOL<ACCESSOR_CPU>(u16 value);
+template void StateMachine<1>::pokeAUDxVOL<ACCESSOR_AGNUS>(u16 value);
+template void StateMachine<2>::pokeAUDxVOL<ACCESSOR_CPU>(u16 value);
+template void StateMachine<2>::pokeAUDxVOL<ACCESSOR_AGNUS>(u16 value);
+template void StateMachine<3>::pokeAUDxVOL<ACCESSOR_CPU>(u16 value);
+template void StateMachine<3>::pokeAUDxVOL<ACCESSOR_AGNUS>(u16 value);
 
-template void StateMachine<0>::pokeAUDxDAT(u16 value);
-template void StateMachine<1>::pokeAUDxDAT(u16 value);
-template void StateMachine<2>::pokeAUDxDAT(u16 value);
-template void StateMachine<3>::pokeAUDxDAT(u16 value);
+template void StateMachine<0>::pokeAUDxDAT<ACCESSOR_CPU>(u16 value);
+template void StateMachine<0>::pokeAUDxDAT<ACCESSOR_AGNUS>(u16 value);
+template void StateMachine<1>::pokeAUDxDAT<ACCESSOR_CPU>(u16 value);
+template void StateMachine<1>::pokeAUDxDAT<ACCESSOR_AGNUS>(u16 value);
+template void StateMachine<2>::pokeAUDxDAT<ACCESSOR_CPU>(u16 value);
+template void StateMachine<2>::pokeAUDxDAT<ACCESSOR_AGNUS>(u16 value);
+template void StateMachine<3>::pokeAUDxDAT<ACCESSOR_CPU>(u16 value);
+template void StateMachine<3>::pokeAUDxDAT<ACCESSOR_AGNUS>(u16 value);
 
 }
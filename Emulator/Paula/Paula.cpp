@@ -166,7 +166,8 @@ Paula::interruptLevel()
 void
 Paula::eofHandler() {
 
-    muxer.stats.fillLevel = muxer.stream.fillLevel();
+    muxer.updateStats();
+    muxer.capture.eofHandler();
 }
 
 }
@@ -218,7 +218,7 @@ private:
 public:
 
     u16 peekADKCONR() const;
-    void pokeADKCON(u16 value);
+    template <Accessor s> void pokeADKCON(u16 value);
 
     u16 peekINTREQR() const;
     template <Accessor s> void pokeINTREQ(u16 value);
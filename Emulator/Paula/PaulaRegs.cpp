@@ -22,7 +22,7 @@ Paula::peekADKCONR() const
     return adkcon;
 }
 
-void
+template <Accessor s> void
 Paula::pokeADKCON(u16 value)
 {
     debug(AUDREG_DEBUG || DSKREG_DEBUG, "pokeADKCON(%x)\n", value);
@@ -44,6 +44,12 @@ Paula::pokeADKCON(u16 value)
         xfiles("ADKCON: FAST cleared (GCR) (%x)\n", value);
     }
 
+    // The attach bits affect the audio state machines
+    channel0.sync<s>();
+    channel1.sync<s>();
+    channel2.sync<s>();
+    channel3.sync<s>();
+
     if (set) adkcon |= (value & 0x7FFF); else adkcon &= ~value;
 
     // Take care of a possible change of the UARTBRK bit
@@ -177,6 +183,8 @@ Paula::pokePOTGO(u16 value)
     }
 }
 
+template void Paula::pokeADKCON<ACCESSOR_CPU>(u16 value);
+template void Paula::pokeADKCON<ACCESSOR_AGNUS>(u16 value);
 template void Paula::pokeINTREQ<ACCESSOR_CPU>(u16 value);
 template void Paula::pokeINTREQ<ACCESSOR_AGNUS>(u16 value);
 template void Paula::pokeINTENA<ACCESSOR_CPU>(u16 value);
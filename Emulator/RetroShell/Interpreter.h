@@ -19,27 +19,27 @@ namespace vamiga {
 
 enum class Token
 {
-    about, accuracy, activation, agnus, amiga, at, attach, audiate, audio,
-    autofire, autosync, bankmap, beam, bitplanes, blitter, bp, brightness,
-    bullets, cbp, channel, checksums, chip, cia, ciaa, ciab, clear, close,
+    about, accuracy, activation, agnus, amiga, analyze, append, at, attach, audiate,
+    audio, autofire, autosync, bankmap, beam, bitplanes, blitter, bp, brightness,
+    bullets, capture, cbp, channel, check, checksums, chip, cia, ciaa, ciab, clear, close,
     clxsprspr, clxsprplf, clxplfplf, color, config, connect, contrast,
     controlport, copper, cp, cpu, cutout, cwp, dasm, dc, debug, defaults,
     delay, del, denise, detach, device, devices, dfn, diagboard, disassemble,
     down, disable, disconnect, disk, dma, dmadebugger, drive, dsksync,
-    easteregg, eject, enable, esync, events, execbase, extrom, extstart, fast,
-    filename, filesystem, filter, fpu, gdb, geometry, hdn, help, hide, host,
-    ignore, init, info, insert, inspect, interrupt, interrupts, joystick, jump,
+    easteregg, eject, enable, esync, events, execbase, exit, extrom, extstart, fast,
+    filename, filesystem, filter, fpu, gdb, geometry, hashes, hdn, help, hide,
+    host, ignore, init, info, insert, inspect, interrupt, interrupts, joystick, jump,
     keyboard, keyset, layers, left, library, libraries, list, load, lock,
-    mechanics, memdump, memory, mmu, mode, model, monitor, mouse, next, none,
+    manifest, mechanics, memdump, memory, mmu, mode, model, monitor, mouse, next, none,
     opacity, open, os, overclocking, palette, pan, partition, path,
-    paula, pause, ptrdrops, poll, port, ports, power, press, process,
-    processes, pull, pullup, raminitpattern, refresh, registers, regreset,
+    paula, pause, pipeline, ptrdrops, poll, port, ports, power, press, process,
+    processes, pull, pullup, raminitpattern, recorder, refresh, registers, regreset,
     regression, release, reset, resource, resources, revision, right, rom, rpm,
     rshell, rtc, run, sampling, saturation, save, saveroms, screenshot,
-    searchpath, serial, server, set, setup, shakedetector, show, slow,
-    slowramdelay, slowrammirror, source, speed, sprites, start, status, step,
-    stop, swapdelay, swtraps, syntax, task, tasks, tod, todbug, tracking,
-    translate, trap, type, uart, unmappingtype, unpress, up, vector, vectors,
+    searchpath, serial, server, set, setup, shakedetector, sharedmem, show, slow,
+    slowramdelay, slowrammirror, source, speed, sprites, start, stats, status, step,
+    stop, swapdelay, swtraps, syntax, task, tasks, tod, todbug, trace,
+    tracking, translate, trap, type, uart, unmappingtype, unpress, up, vector, vectors,
     verbose, velocity, volume, volumes, vsync, wait, watch, watchpoint, wom,
     wp, write, xaxis, yaxis, zorro
 };
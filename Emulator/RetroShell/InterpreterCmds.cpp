@@ -118,6 +118,10 @@ Interpreter::initCommandShell(Command &root)
     root.add({"regression", "run"}, { Arg::path },
              "Launches a regression test",
              &RetroShell::exec <Token::regression, Token::run>);
+
+    root.add({"regression", "exit"},
+             "Exits the emulator with the test result",
+             &RetroShell::exec <Token::regression, Token::exit>);
     
     root.add({"screenshot"},
              "Manages regression tests");
@@ -133,10 +137,22 @@ Interpreter::initCommandShell(Command &root)
              "Adjusts the texture cutout",
              &RetroShell::exec <Token::screenshot, Token::set, Token::cutout>);
 
+    root.add({"screenshot", "set", "manifest"}, { Arg::path },
+             "Assigns the manifest with the expected texture hashes",
+             &RetroShell::exec <Token::screenshot, Token::set, Token::manifest>);
+
     root.add({"screenshot", "save"}, { Arg::path },
              "Saves a screenshot and exits the emulator",
              &RetroShell::exec <Token::screenshot, Token::save>);
 
+    root.add({"screenshot", "append"}, { Arg::path },
+             "Appends a screenshot to a frame stream",
+             &RetroShell::exec <Token::screenshot, Token::append>);
+
+    root.add({"screenshot", "check"}, { Arg::name },
+             "Compares the texture hash against the manifest",
+             &RetroShell::exec <Token::screenshot, Token::check>);
+
     
     //
     // Amiga
@@ -397,6 +413,36 @@ Interpreter::initCommandShell(Command &root)
              "Makes certain drawing layers transparent",
              &RetroShell::exec <Token::denise, Token::set, Token::hide, Token::layers>);
 
+    root.add({"denise", "recorder"},
+             "Screen recorder");
+
+    root.add({"denise", "recorder", "start"},
+             "Starts recording with the built-in encoder",
+             &RetroShell::exec <Token::denise, Token::recorder, Token::start>);
+
+    root.add({"denise", "recorder", "stop"},
+             "Stops recording",
+             &RetroShell::exec <Token::denise, Token::recorder, Token::stop>);
+
+    root.add({"denise", "recorder", "save"}, { Arg::path },
+             "Exports the recorded video",
+             &RetroShell::exec <Token::denise, Token::recorder, Token::save>);
+
+    root.add({"denise", "sharedmem"},
+             "Shared memory export");
+
+    root.add({"denise", "sharedmem", ""},
+             "Displays the current state",
+             &RetroShell::exec <Token::denise, Token::sharedmem>);
+
+    root.add({"denise", "sharedmem", "open"}, { Arg::name },
+             "Publishes all frames in a shared memory object",
+             &RetroShell::exec <Token::denise, Token::sharedmem, Token::open>);
+
+    root.add({"denise", "sharedmem", "close"},
+             "Removes the shared memory object",
+             &RetroShell::exec <Token::denise, Token::sharedmem, Token::close>);
+
     
     //
     // DMA Debugger
@@ -442,6 +488,21 @@ Interpreter::initCommandShell(Command &root)
              "Turn memory refresh visualization on or off",
              &RetroShell::exec <Token::dmadebugger, Token::refresh>);
 
+    root.add({"dmadebugger", "trace"},
+             "Records DMA bus traces");
+
+    root.add({"dmadebugger", "trace", "start"}, { Arg::path },
+             "Starts writing the DMA bus usage to a trace file",
+             &RetroShell::exec <Token::dmadebugger, Token::trace, Token::start>);
+
+    root.add({"dmadebugger", "trace", "stop"},
+             "Stops recording the DMA trace",
+             &RetroShell::exec <Token::dmadebugger, Token::trace, Token::stop>);
+
+    root.add({"dmadebugger", "trace", "analyze"}, { Arg::path },
+             "Summarizes the bus usage recorded in a trace file",
+             &RetroShell::exec <Token::dmadebugger, Token::trace, Token::analyze>);
+
 
     //
     // Monitor
@@ -470,6 +531,10 @@ Interpreter::initCommandShell(Command &root)
              "Adjusts the saturation of the Amiga texture",
              &RetroShell::exec <Token::monitor, Token::set, Token::saturation>);
 
+    root.add({"monitor", "set", "pipeline"}, { Arg::boolean },
+             "Colorizes rasterlines on a separate thread",
+             &RetroShell::exec <Token::monitor, Token::set, Token::pipeline>);
+
     
     //
     // Paula (Audio)
@@ -552,6 +617,21 @@ Interpreter::initCommandShell(Command &root)
              "Sets the pan for audio channel 3",
              &RetroShell::exec <Token::audio, Token::set, Token::pan>, 3);
 
+    root.add({"paula", "audio", "capture"},
+             "Records the audio output");
+
+    root.add({"paula", "audio", "capture", "start"}, { Arg::path },
+             "Starts recording into a WAV or raw PCM file",
+             &RetroShell::exec <Token::audio, Token::capture, Token::start>);
+
+    root.add({"paula", "audio", "capture", "hashes"}, { Arg::path },
+             "Writes a hash value for each recorded frame",
+             &RetroShell::exec <Token::audio, Token::capture, Token::hashes>);
+
+    root.add({"paula", "audio", "capture", "stop"},
+             "Stops recording",
+             &RetroShell::exec <Token::audio, Token::capture, Token::stop>);
+
 
     //
     // Paula (Disk controller)
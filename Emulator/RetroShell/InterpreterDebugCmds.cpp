@@ -409,6 +409,10 @@ Interpreter::initDebugShell(Command &root)
              "Displays additional debug information",
              &RetroShell::exec <Token::paula, Token::audio, Token::debug>);
 
+    root.add({"paula", "audio", "stats"},
+             "Displays buffer and latency statistics",
+             &RetroShell::exec <Token::paula, Token::audio, Token::stats>);
+
     root.add({"paula", "dc", ""},
              "Inspects the internal state",
              &RetroShell::exec <Token::paula, Token::dc>);
@@ -589,9 +589,10 @@ void
 RetroShell::eofHandler()
 {
     if (agnus.clock >= wakeUp) {
-        
-        msgQueue.put(MSG_SCRIPT_WAKEUP);
+
+        // Reset the alarm first, as the script may set a new one right away
         wakeUp = INT64_MAX;
+        msgQueue.put(MSG_SCRIPT_WAKEUP);
     }
 }
 
@@ -99,6 +99,12 @@ RetroShell::exec <Token::regression, Token::run> (Arguments &argv, long param)
     amiga.regressionTester.run(argv.front());
 }
 
+template <> void
+RetroShell::exec <Token::regression, Token::exit> (Arguments &argv, long param)
+{
+    amiga.regressionTester.exit();
+}
+
 template <> void
 RetroShell::exec <Token::screenshot, Token::set, Token::filename> (Arguments &argv, long param)
 {
@@ -121,12 +127,30 @@ RetroShell::exec <Token::screenshot, Token::set, Token::cutout> (Arguments &argv
     amiga.regressionTester.y2 = y2;
 }
 
+template <> void
+RetroShell::exec <Token::screenshot, Token::set, Token::manifest> (Arguments &argv, long param)
+{
+    amiga.regressionTester.manifestPath = argv.front();
+}
+
 template <> void
 RetroShell::exec <Token::screenshot, Token::save> (Arguments &argv, long param)
 {
     amiga.regressionTester.dumpTexture(amiga, argv.front());
 }
 
+template <> void
+RetroShell::exec <Token::screenshot, Token::append> (Arguments &argv, long param)
+{
+    amiga.regressionTester.appendTexture(amiga, argv.front());
+}
+
+template <> void
+RetroShell::exec <Token::screenshot, Token::check> (Arguments &argv, long param)
+{
+    amiga.regressionTester.checkTexture(amiga, argv.front());
+}
+
 
 //
 // Amiga
@@ -525,6 +549,60 @@ RetroShell::exec <Token::denise, Token::set, Token::hide, Token::layers> (Argume
     amiga.configure(OPT_HIDDEN_LAYERS, util::parseNum(argv.front()));
 }
 
+template <> void
+RetroShell::exec <Token::denise, Token::recorder, Token::start> (Arguments &argv, long param)
+{
+    auto &tester = amiga.regressionTester;
+
+    {   SUSPENDED
+
+        amiga.denise.screenRecorder.startRecording(tester.x1, tester.y1,
+                                                   tester.x2, tester.y2,
+                                                   0, 1, 1, true);
+    }
+}
+
+template <> void
+RetroShell::exec <Token::denise, Token::recorder, Token::stop> (Arguments &argv, long param)
+{
+    {   SUSPENDED
+
+        amiga.denise.screenRecorder.stopRecording();
+    }
+}
+
+template <> void
+RetroShell::exec <Token::denise, Token::recorder, Token::save> (Arguments &argv, long param)
+{
+    if (!amiga.denise.screenRecorder.exportAs(argv.front())) {
+        throw VAError(ERROR_FILE_CANT_WRITE, argv.front());
+    }
+}
+
+template <> void
+RetroShell::exec <Token::denise, Token::sharedmem> (Arguments &argv, long param)
+{
+    dump(amiga.denise.frameExport, Category::Inspection);
+}
+
+template <> void
+RetroShell::exec <Token::denise, Token::sharedmem, Token::open> (Arguments &argv, long param)
+{
+    {   SUSPENDED
+
+        amiga.denise.frameExport.open(argv.front());
+    }
+}
+
+template <> void
+RetroShell::exec <Token::denise, Token::sharedmem, Token::close> (Arguments &argv, long param)
+{
+    {   SUSPENDED
+
+        amiga.denise.frameExport.close();
+    }
+}
+
 
 //
 // DMA Debugger
@@ -590,6 +668,26 @@ RetroShell::exec <Token::dmadebugger, Token::refresh> (Arguments& argv, long par
     amiga.configure(OPT_DMA_DEBUG_CHANNEL, DMA_CHANNEL_REFRESH, util::parseBool(argv.front()));
 }
 
+template <> void
+RetroShell::exec <Token::dmadebugger, Token::trace, Token::start> (Arguments& argv, long param)
+{
+    amiga.agnus.dmaDebugger.startTrace(argv.front());
+}
+
+template <> void
+RetroShell::exec <Token::dmadebugger, Token::trace, Token::stop> (Arguments& argv, long param)
+{
+    amiga.agnus.dmaDebugger.stopTrace();
+}
+
+template <> void
+RetroShell::exec <Token::dmadebugger, Token::trace, Token::analyze> (Arguments& argv, long param)
+{
+    std::stringstream ss;
+    DmaDebugger::analyzeTrace(argv.front(), ss);
+    *this << ss;
+}
+
 
 //
 // Monitor
@@ -625,6 +723,12 @@ RetroShell::exec <Token::monitor, Token::set, Token::saturation> (Arguments& arg
     amiga.configure(OPT_SATURATION, util::parseNum(argv.front()));
 }
 
+template <> void
+RetroShell::exec <Token::monitor, Token::set, Token::pipeline> (Arguments& argv, long param)
+{
+    amiga.configure(OPT_COLOR_PIPELINE, util::parseBool(argv.front()));
+}
+
 
 //
 // Audio
@@ -689,6 +793,39 @@ RetroShell::exec <Token::audio, Token::set, Token::pan> (Arguments& argv, long p
     amiga.configure(OPT_AUDPAN, param, util::parseNum(argv.front()));
 }
 
+template <> void
+RetroShell::exec <Token::audio, Token::capture, Token::start> (Arguments& argv, long param)
+{
+    auto &muxer = amiga.paula.muxer;
+
+    {   SUSPENDED
+
+        muxer.capture.start(argv.front(), isize(host.getSampleRate()));
+    }
+}
+
+template <> void
+RetroShell::exec <Token::audio, Token::capture, Token::hashes> (Arguments& argv, long param)
+{
+    auto &muxer = amiga.paula.muxer;
+
+    {   SUSPENDED
+
+        muxer.capture.startHashing(argv.front());
+    }
+}
+
+template <> void
+RetroShell::exec <Token::audio, Token::capture, Token::stop> (Arguments& argv, long param)
+{
+    auto &muxer = amiga.paula.muxer;
+
+    {   SUSPENDED
+
+        muxer.capture.stop();
+    }
+}
+
 
 //
 // Paula
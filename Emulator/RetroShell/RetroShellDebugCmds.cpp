@@ -503,6 +503,12 @@ RetroShell::exec <Token::paula, Token::audio, Token::debug> (Arguments& argv, lo
     dumpDetails(amiga.paula.muxer);
 }
 
+template <> void
+RetroShell::exec <Token::paula, Token::audio, Token::stats> (Arguments& argv, long param)
+{
+    dump(amiga.paula.muxer, Category::Stats);
+}
+
 template <> void
 RetroShell::exec <Token::paula, Token::dc> (Arguments& argv, long param)
 {
@@ -0,0 +1,284 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#include "config.h"
+#include "ImageUtils.h"
+#include "Checksum.h"
+#include <algorithm>
+#include <cstring>
+
+namespace util {
+
+void encodeQOI(const u8 *rgb, isize width, isize height, std::vector<u8> &out)
+{
+    auto put32 = [&](u32 value) {
+        out.push_back(u8(value >> 24));
+        out.push_back(u8(value >> 16));
+        out.push_back(u8(value >> 8));
+        out.push_back(u8(value));
+    };
+
+    // Reserve space for the worst case (one RGB chunk per pixel)
+    out.reserve(out.size() + 14 + 4 * width * height + 8);
+
+    // Write header (magic bytes, size, channels, color space)
+    put32(0x716f6966);
+    put32(u32(width));
+    put32(u32(height));
+    out.push_back(3);
+    out.push_back(0);
+
+    u32 index[64] = { };
+    u8 pr = 0, pg = 0, pb = 0;
+    isize run = 0;
+
+    for (isize i = 0, count = width * height; i < count; i++, rgb += 3) {
+
+        u8 r = rgb[0], g = rgb[1], b = rgb[2];
+
+        // Extend the current run if the pixel repeats
+        if (r == pr && g == pg && b == pb) {
+
+            if (++run == 62) { out.push_back(u8(0xC0 | (run - 1))); run = 0; }
+            continue;
+        }
+        if (run) { out.push_back(u8(0xC0 | (run - 1))); run = 0; }
+
+        // Check if the pixel has been seen recently
+        u32 px = r << 24 | g << 16 | b << 8 | 0xFF;
+        isize hash = (r * 3 + g * 5 + b * 7 + 255 * 11) % 64;
+
+        if (index[hash] == px) {
+
+            out.push_back(u8(hash));
+
+        } else {
+
+            index[hash] = px;
+
+            // Encode the pixel as a difference to its predecessor if possible
+            i8 vr = i8(r - pr), vg = i8(g - pg), vb = i8(b - pb);
+            i8 vgr = i8(vr - vg), vgb = i8(vb - vg);
+
+            if (vr >= -2 && vr <= 1 && vg >= -2 && vg <= 1 && vb >= -2 && vb <= 1) {
+
+                out.push_back(u8(0x40 | (vr + 2) << 4 | (vg + 2) << 2 | (vb + 2)));
+
+            } else if (vgr >= -8 && vgr <= 7 && vg >= -32 && vg <= 31 && vgb >= -8 && vgb <= 7) {
+
+                out.push_back(u8(0x80 | (vg + 32)));
+                out.push_back(u8((vgr + 8) << 4 | (vgb + 8)));
+
+            } else {
+
+                out.push_back(0xFE);
+                out.push_back(r);
+                out.push_back(g);
+                out.push_back(b);
+            }
+        }
+        pr = r; pg = g; pb = b;
+    }
+    if (run) out.push_back(u8(0xC0 | (run - 1)));
+
+    // Write end marker
+    put32(0);
+    put32(1);
+}
+
+namespace {
+
+// Writes a bit stream in deflate order (least significant bit first)
+struct BitWriter {
+
+    std::vector<u8> &out;
+    u32 bits = 0;
+    isize count = 0;
+
+    void put(u32 value, isize n) {
+
+        bits |= value << count;
+        for (count += n; count >= 8; count -= 8, bits >>= 8) out.push_back(u8(bits));
+    }
+
+    // Huffman codes are stored with the most significant bit first
+    void putCode(u32 code, isize n) {
+
+        u32 reversed = 0;
+        for (isize i = 0; i < n; i++) reversed = (reversed << 1) | ((code >> i) & 1);
+        put(reversed, n);
+    }
+
+    // Writes a literal or a length symbol using the fixed Huffman code
+    void putSymbol(isize symbol) {
+
+        if (symbol < 144) { putCode(u32(0x30 + symbol), 8); return; }
+        if (symbol < 256) { putCode(u32(0x190 + symbol - 144), 9); return; }
+        if (symbol < 280) { putCode(u32(symbol - 256), 7); return; }
+        putCode(u32(0xC0 + symbol - 280), 8);
+    }
+
+    void flush() { if (count) out.push_back(u8(bits)); bits = 0; count = 0; }
+};
+
+constexpr u16 lenBase[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+constexpr u8 lenExtra[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+constexpr u16 distBase[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+};
+constexpr u8 distExtra[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+void deflate(const u8 *data, isize size, isize stride, std::vector<u8> &out)
+{
+    constexpr isize window = 32768;
+    constexpr isize maxLength = 258;
+    constexpr isize hashBits = 15;
+
+    BitWriter writer { out };
+    std::vector<i32> head(1 << hashBits, -1);
+
+    auto hash = [&](isize i) {
+        u32 key = data[i] << 16 | data[i + 1] << 8 | data[i + 2];
+        return (key * 2654435761U) >> (32 - hashBits);
+    };
+    auto matchLength = [&](isize from, isize i) {
+        isize max = std::min(maxLength, size - i), len = 0;
+        while (len < max && data[from + len] == data[i + len]) len++;
+        return len;
+    };
+
+    // Single final block with fixed Huffman codes
+    writer.put(1, 1);
+    writer.put(1, 2);
+
+    for (isize i = 0; i < size;) {
+
+        isize bestLen = 0, bestDist = 0;
+
+        if (i + 3 <= size) {
+
+            // Try the previous pixel, the pixel above, and the hashed position
+            auto h = hash(i);
+            isize candidates[3] = { i - 3, i - stride, head[h] };
+            head[h] = i32(i);
+
+            for (auto from : candidates) {
+
+                if (from < 0 || from >= i || i - from > window) continue;
+                if (auto len = matchLength(from, i); len > bestLen) {
+                    bestLen = len;
+                    bestDist = i - from;
+                }
+            }
+        }
+
+        if (bestLen < 3) {
+
+            writer.putSymbol(data[i++]);
+            continue;
+        }
+
+        // Write the length
+        isize l = 28;
+        while (lenBase[l] > bestLen) l--;
+        writer.putSymbol(257 + l);
+        writer.put(u32(bestLen - lenBase[l]), lenExtra[l]);
+
+        // Write the distance
+        isize d = 29;
+        while (distBase[d] > bestDist) d--;
+        writer.putCode(u32(d), 5);
+        writer.put(u32(bestDist - distBase[d]), distExtra[d]);
+
+        i += bestLen;
+    }
+
+    // End of block
+    writer.putSymbol(256);
+    writer.flush();
+}
+
+u32 adler32(const u8 *data, isize size)
+{
+    u32 a = 1, b = 0;
+
+    while (size > 0) {
+
+        // Postpone the modulo operation as long as no overflow can occur
+        isize chunk = std::min(size, isize(5552));
+        for (isize i = 0; i < chunk; i++) { a += data[i]; b += a; }
+        a %= 65521; b %= 65521;
+        data += chunk; size -= chunk;
+    }
+    return b << 16 | a;
+}
+
+}
+
+void encodePNG(const u8 *rgb, isize width, isize height, std::vector<u8> &out)
+{
+    auto put32 = [&](u32 value) {
+        out.push_back(u8(value >> 24));
+        out.push_back(u8(value >> 16));
+        out.push_back(u8(value >> 8));
+        out.push_back(u8(value));
+    };
+    auto chunk = [&](u32 type, auto &&body) {
+        isize start = isize(out.size());
+        put32(0);
+        put32(type);
+        body();
+        auto length = u32(out.size() - start - 8);
+        for (isize i = 0; i < 4; i++) out[start + i] = u8(length >> (24 - 8 * i));
+        put32(util::crc32(out.data() + start + 4, isize(out.size()) - start - 4));
+    };
+
+    // Prepend each row with filter type 0 (none)
+    isize stride = 1 + 3 * width;
+    std::vector<u8> raw(stride * height);
+    for (isize y = 0; y < height; y++) {
+
+        raw[y * stride] = 0;
+        std::memcpy(raw.data() + y * stride + 1, rgb + y * 3 * width, 3 * width);
+    }
+
+    // Write signature
+    put32(0x89504e47);
+    put32(0x0d0a1a0a);
+
+    // Write header (size, bit depth, RGB color, no interlacing)
+    chunk(0x49484452, [&]() {
+        put32(u32(width));
+        put32(u32(height));
+        out.insert(out.end(), { 8, 2, 0, 0, 0 });
+    });
+
+    // Write the image data as a zlib stream
+    chunk(0x49444154, [&]() {
+        out.push_back(0x78);
+        out.push_back(0x01);
+        deflate(raw.data(), isize(raw.size()), stride, out);
+        put32(adler32(raw.data(), isize(raw.size())));
+    });
+
+    // Write end marker
+    chunk(0x49454e44, []() { });
+}
+
+}
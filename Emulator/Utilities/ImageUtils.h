@@ -0,0 +1,42 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#pragma once
+
+#include "Types.h"
+#include <vector>
+
+namespace util {
+
+/* Encodes an RGB image in the "Quite OK Image" format (QOI).
+ *
+ *     Input:   A pointer to a u8[3 * width * height] array.
+ *              Pixels are stored row by row with one byte per channel.
+ *     Output:  The encoded image, appended to the provided vector.
+ *
+ * QOI is a lossless format which can be decoded by many image viewers. Large
+ * areas of equal color, which are common in emulator screenshots, compress
+ * into short run-length codes.
+ */
+void encodeQOI(const u8 *rgb, isize width, isize height, std::vector<u8> &out);
+
+/* Encodes an RGB image in the "Portable Network Graphics" format (PNG).
+ *
+ *     Input:   A pointer to a u8[3 * width * height] array (see above).
+ *     Output:  The encoded image, appended to the provided vector.
+ *
+ * The encoder is kept simple in favor of speed. It uses a single deflate
+ * block with fixed Huffman codes. Matches are searched at the previous pixel,
+ * the pixel above, and at the most recent position with the same hash value.
+ * This is sufficient to compress the large uniform areas of Amiga screens
+ * efficiently.
+ */
+void encodePNG(const u8 *rgb, isize width, isize height, std::vector<u8> &out);
+
+}
@@ -10,6 +10,12 @@
 #include "config.h"
 #include "SSEUtils.h"
 #include "Macros.h"
+#include <cstring>
+
+#if (defined(__i386__) || defined(__x86_64__)) && (defined(__GNUC__) || defined(__clang__))
+#define HAS_AVX2_KERNELS
+#include <immintrin.h>
+#endif
 
 namespace util {
 
@@ -56,4 +62,322 @@ void transposeSSE(u16 *source, u8* target)
 
 #endif
 
+static void transposeScalar(const u16 *source, u8 *target, isize count)
+{
+    for (isize c = 0; c < count; c++, source += 8, target += 16) {
+
+        for (isize i = 0; i < 16; i++) {
+
+            u8 slice = 0;
+            for (isize r = 0; r < 8; r++) slice |= u8(((source[r] >> (15 - i)) & 1) << r);
+            target[i] = slice;
+        }
+    }
+}
+
+static void mixScalar(const float *const ch[4], const float wl[4], const float wr[4],
+                      float *left, float *right, isize count, isize offset = 0)
+{
+    for (isize i = 0; i < count; i++) {
+
+        float s0 = ch[0][offset + i], s1 = ch[1][offset + i];
+        float s2 = ch[2][offset + i], s3 = ch[3][offset + i];
+
+        left[i] = (s0 * wl[0] + s1 * wl[1]) + (s2 * wl[2] + s3 * wl[3]);
+        right[i] = (s0 * wr[0] + s1 * wr[1]) + (s2 * wr[2] + s3 * wr[3]);
+    }
+}
+
+#ifdef HAS_AVX2_KERNELS
+
+bool hasAVX2()
+{
+    static bool result = __builtin_cpu_supports("avx2");
+    return result;
+}
+
+__attribute__((target("avx2")))
+static void lookupAVX2(const u8 *src, u32 *dst, const u32 *table, isize count)
+{
+    isize i = 0;
+
+    // Translate 8 indices at once
+    for (; i + 8 <= count; i += 8) {
+
+        __m256i indices = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(src + i)));
+        __m256i values = _mm256_i32gather_epi32((const int *)table, indices, 4);
+        _mm256_storeu_si256((__m256i *)(dst + i), values);
+    }
+
+    // Translate the remaining indices
+    for (; i < count; i++) dst[i] = table[src[i]];
+}
+
+__attribute__((target("avx2")))
+static void lookupAVX2(const u8 *src, u64 *dst, const u64 *table, isize count)
+{
+    isize i = 0;
+
+    // Translate 4 indices at once
+    for (; i + 4 <= count; i += 4) {
+
+        u32 packed;
+        std::memcpy(&packed, src + i, sizeof(packed));
+
+        __m128i indices = _mm_cvtepu8_epi32(_mm_cvtsi32_si128((int)packed));
+        __m256i values = _mm256_i32gather_epi64((const long long *)table, indices, 8);
+        _mm256_storeu_si256((__m256i *)(dst + i), values);
+    }
+
+    // Translate the remaining indices
+    for (; i < count; i++) dst[i] = table[src[i]];
+}
+
+__attribute__((target("avx2")))
+static void transposeAVX2(const u16 *source, u8 *target, isize count)
+{
+    // Moves the upper bytes of all rows in front of the lower bytes
+    const __m256i mask1 = _mm256_setr_epi8(1,3,5,7,9,11,13,15,0,2,4,6,8,10,12,14,
+                                           1,3,5,7,9,11,13,15,0,2,4,6,8,10,12,14);
+
+    // Groups the column values by matrix and pixel position
+    const __m256i mask2 = _mm256_setr_epi8(0,4,8,12,1,5,9,13,2,6,10,14,3,7,11,15,
+                                           0,4,8,12,1,5,9,13,2,6,10,14,3,7,11,15);
+    const __m256i order = _mm256_setr_epi32(0,4,1,5,2,6,3,7);
+
+    isize i = 0;
+
+    // Transpose two matrices at once
+    for (; i + 2 <= count; i += 2) {
+
+        __m256i rows = _mm256_loadu_si256((const __m256i *)(source + 8 * i));
+        __m256i shuffled = _mm256_shuffle_epi8(rows, mask1);
+
+        /* Cut off column values. Each 32-bit word contains the columns k and
+         * k + 8 of both matrices in the order
+         * m0.col(k) m0.col(k+8) m1.col(k) m1.col(k+8)
+         */
+        alignas(32) u32 column[8];
+        for (isize k = 0; k < 8; k++) {
+            column[k] = (u32)_mm256_movemask_epi8(shuffled);
+            shuffled = _mm256_slli_epi64(shuffled, 1);
+        }
+
+        // Shuffle back to m0.col0 ... m0.col15 m1.col0 ... m1.col15
+        __m256i result = _mm256_load_si256((const __m256i *)column);
+        result = _mm256_shuffle_epi8(result, mask2);
+        result = _mm256_permutevar8x32_epi32(result, order);
+        _mm256_storeu_si256((__m256i *)(target + 16 * i), result);
+    }
+
+    // Transpose the remaining matrix
+    transposeScalar(source + 8 * i, target + 16 * i, count - i);
+}
+
+// Looks up 32 table values with indices in the range 0 ... 63
+__attribute__((target("avx2")))
+static inline __m256i shuffle64(__m256i indices, const __m256i table[4])
+{
+    indices = _mm256_and_si256(indices, _mm256_set1_epi8(0x3F));
+
+    // Bits 4 and 5 select one of the four 16-byte subtables
+    __m256i select = _mm256_and_si256(_mm256_srli_epi16(indices, 4), _mm256_set1_epi8(3));
+    __m256i result = _mm256_setzero_si256();
+
+    for (int i = 0; i < 4; i++) {
+
+        // Bits 0 to 3 select the value inside the subtable
+        __m256i values = _mm256_shuffle_epi8(table[i], indices);
+        __m256i match = _mm256_cmpeq_epi8(select, _mm256_set1_epi8((char)i));
+        result = _mm256_or_si256(result, _mm256_and_si256(match, values));
+    }
+
+    return result;
+}
+
+__attribute__((target("avx2")))
+static void lookup64AVX2(const u8 *src, u8 *dst, const u8 table[64], isize count)
+{
+    isize i = 0;
+
+    // Replicate the table in both 128-bit lanes
+    __m256i t[4];
+    for (int j = 0; j < 4; j++) {
+        t[j] = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)(table + 16 * j)));
+    }
+
+    // Translate 32 indices at once
+    for (; i + 32 <= count; i += 32) {
+
+        __m256i indices = _mm256_loadu_si256((const __m256i *)(src + i));
+        _mm256_storeu_si256((__m256i *)(dst + i), shuffle64(indices, t));
+    }
+
+    // Translate the remaining indices
+    for (; i < count; i++) dst[i] = table[src[i] & 0x3F];
+}
+
+__attribute__((target("avx2")))
+static void lookup64AVX2(const u8 *src, u16 *dst, const u16 table[64], isize count)
+{
+    isize i = 0;
+
+    // Split the table into a low-byte table and a high-byte table
+    u8 lo[64], hi[64];
+    for (int j = 0; j < 64; j++) { lo[j] = LO_BYTE(table[j]); hi[j] = HI_BYTE(table[j]); }
+
+    __m256i tlo[4], thi[4];
+    for (int j = 0; j < 4; j++) {
+        tlo[j] = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)(lo + 16 * j)));
+        thi[j] = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)(hi + 16 * j)));
+    }
+
+    // Translate 32 indices at once
+    for (; i + 32 <= count; i += 32) {
+
+        __m256i indices = _mm256_loadu_si256((const __m256i *)(src + i));
+        __m256i vlo = shuffle64(indices, tlo);
+        __m256i vhi = shuffle64(indices, thi);
+
+        // Interleave the low and the high bytes (in-lane)
+        __m256i a = _mm256_unpacklo_epi8(vlo, vhi);
+        __m256i b = _mm256_unpackhi_epi8(vlo, vhi);
+
+        // Restore the original element order
+        _mm256_storeu_si256((__m256i *)(dst + i), _mm256_permute2x128_si256(a, b, 0x20));
+        _mm256_storeu_si256((__m256i *)(dst + i + 16), _mm256_permute2x128_si256(a, b, 0x31));
+    }
+
+    // Translate the remaining indices
+    for (; i < count; i++) dst[i] = table[src[i] & 0x3F];
+}
+
+__attribute__((target("avx2")))
+static isize findMaskedAVX2(const u8 *src, isize count, u8 mask, u8 value)
+{
+    const __m256i vmask = _mm256_set1_epi8((char)mask);
+    const __m256i vvalue = _mm256_set1_epi8((char)value);
+
+    isize i = 0;
+
+    // Compare 32 elements at once
+    for (; i + 32 <= count; i += 32) {
+
+        __m256i data = _mm256_loadu_si256((const __m256i *)(src + i));
+        __m256i match = _mm256_cmpeq_epi8(_mm256_and_si256(data, vmask), vvalue);
+        if (u32 bits = (u32)_mm256_movemask_epi8(match)) return i + __builtin_ctz(bits);
+    }
+
+    // Compare the remaining elements
+    for (; i < count; i++) if ((src[i] & mask) == value) return i;
+    return -1;
+}
+
+__attribute__((target("avx2")))
+static void mixAVX2(const float *const ch[4], const float wl[4], const float wr[4],
+                    float *left, float *right, isize count)
+{
+    __m256 l[4], r[4];
+    for (int c = 0; c < 4; c++) {
+        l[c] = _mm256_set1_ps(wl[c]);
+        r[c] = _mm256_set1_ps(wr[c]);
+    }
+
+    isize i = 0;
+
+    // Mix 8 samples at once
+    for (; i + 8 <= count; i += 8) {
+
+        __m256 s0 = _mm256_loadu_ps(ch[0] + i);
+        __m256 s1 = _mm256_loadu_ps(ch[1] + i);
+        __m256 s2 = _mm256_loadu_ps(ch[2] + i);
+        __m256 s3 = _mm256_loadu_ps(ch[3] + i);
+
+        __m256 sl = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(s0, l[0]), _mm256_mul_ps(s1, l[1])),
+                                  _mm256_add_ps(_mm256_mul_ps(s2, l[2]), _mm256_mul_ps(s3, l[3])));
+        __m256 sr = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(s0, r[0]), _mm256_mul_ps(s1, r[1])),
+                                  _mm256_add_ps(_mm256_mul_ps(s2, r[2]), _mm256_mul_ps(s3, r[3])));
+
+        _mm256_storeu_ps(left + i, sl);
+        _mm256_storeu_ps(right + i, sr);
+    }
+
+    // Mix the remaining samples
+    mixScalar(ch, wl, wr, left + i, right + i, count - i, i);
+}
+
+#else
+
+bool hasAVX2()
+{
+    return false;
+}
+
+#endif
+
+void transpose(const u16 *source, u8 *target, isize count)
+{
+#ifdef HAS_AVX2_KERNELS
+    if (hasAVX2()) { transposeAVX2(source, target, count); return; }
+#endif
+
+    transposeScalar(source, target, count);
+}
+
+void lookup(const u8 *src, u32 *dst, const u32 *table, isize count)
+{
+#ifdef HAS_AVX2_KERNELS
+    if (hasAVX2()) { lookupAVX2(src, dst, table, count); return; }
+#endif
+
+    for (isize i = 0; i < count; i++) dst[i] = table[src[i]];
+}
+
+void lookup(const u8 *src, u64 *dst, const u64 *table, isize count)
+{
+#ifdef HAS_AVX2_KERNELS
+    if (hasAVX2()) { lookupAVX2(src, dst, table, count); return; }
+#endif
+
+    for (isize i = 0; i < count; i++) dst[i] = table[src[i]];
+}
+
+void lookup64(const u8 *src, u8 *dst, const u8 table[64], isize count)
+{
+#ifdef HAS_AVX2_KERNELS
+    if (hasAVX2()) { lookup64AVX2(src, dst, table, count); return; }
+#endif
+
+    for (isize i = 0; i < count; i++) dst[i] = table[src[i] & 0x3F];
+}
+
+void lookup64(const u8 *src, u16 *dst, const u16 table[64], isize count)
+{
+#ifdef HAS_AVX2_KERNELS
+    if (hasAVX2()) { lookup64AVX2(src, dst, table, count); return; }
+#endif
+
+    for (isize i = 0; i < count; i++) dst[i] = table[src[i] & 0x3F];
+}
+
+isize findMasked(const u8 *src, isize count, u8 mask, u8 value)
+{
+#ifdef HAS_AVX2_KERNELS
+    if (hasAVX2()) return findMaskedAVX2(src, count, mask, value);
+#endif
+
+    for (isize i = 0; i < count; i++) if ((src[i] & mask) == value) return i;
+    return -1;
+}
+
+void mix(const float *const ch[4], const float wl[4], const float wr[4],
+         float *left, float *right, isize count)
+{
+#ifdef HAS_AVX2_KERNELS
+    if (hasAVX2()) { mixAVX2(ch, wl, wr, left, right, count); return; }
+#endif
+
+    mixScalar(ch, wl, wr, left, right, count);
+}
+
 }
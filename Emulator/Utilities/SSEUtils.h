@@ -35,4 +35,58 @@ namespace util {
  */
 void transposeSSE(u16 *source, u8* target);
 
+/* Transposes a sequence of 8 x 16 bit matrices.
+ *
+ *     Input:   A pointer to a u16[8 * count] array.
+ *              Each matrix is made up of 8 consecutive rows.
+ *     Output:  A pointer to a u8[16 * count] array.
+ *              Each matrix is transposed as described for transposeSSE().
+ *
+ * On x86 hosts supporting AVX2, two matrices are transposed at once. On all
+ * other hosts, a scalar implementation is used.
+ */
+void transpose(const u16 *source, u8 *target, isize count);
+
+/* Translates a sequence of 8-bit indices into table values.
+ *
+ *     dst[i] = table[src[i]] for i = 0 ... count - 1
+ *
+ * On x86 hosts supporting AVX2, the lookup is carried out with gather
+ * instructions. On all other hosts, a scalar implementation is used.
+ */
+void lookup(const u8 *src, u32 *dst, const u32 *table, isize count);
+void lookup(const u8 *src, u64 *dst, const u64 *table, isize count);
+
+/* Translates a sequence of 6-bit indices into table values.
+ *
+ *     dst[i] = table[src[i] & 0x3F] for i = 0 ... count - 1
+ *
+ * On x86 hosts supporting AVX2,
+ * 32 indices are translated at once by in-register byte shuffles.
+ */
+void lookup64(const u8 *src, u8 *dst, const u8 table[64], isize count);
+void lookup64(const u8 *src, u16 *dst, const u16 table[64], isize count);
+
+/* Searches a byte sequence for the first element matching a bit pattern.
+ *
+ *     Returns the smallest i with (src[i] & mask) == value or -1 if no such
+ *     element exists.
+ *
+ * On x86 hosts supporting AVX2, 32 elements are compared at once.
+ */
+isize findMasked(const u8 *src, isize count, u8 mask, u8 value);
+
+/* Mixes four audio channels into a stereo signal.
+ *
+ *     left[i]  = ch[0][i] * wl[0] + ... + ch[3][i] * wl[3]
+ *     right[i] = ch[0][i] * wr[0] + ... + ch[3][i] * wr[3]
+ *
+ * On x86 hosts supporting AVX2, eight samples are mixed at once.
+ */
+void mix(const float *const ch[4], const float wl[4], const float wr[4],
+         float *left, float *right, isize count);
+
+// Indicates whether AVX2 instructions are supported by the host CPU
+bool hasAVX2();
+
 }
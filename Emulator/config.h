@@ -112,7 +112,11 @@
 //
 
 static const int NO_SEQ_FASTPATH = 0; // Disable sequencer fast path
+static const int NO_SEQ_CACHE    = 0; // Disable sequencer event table cache
 static const int NO_BPL_FASTPATH = 0; // Disable drawing fast path
+static const int NO_BPL_BATCHING = 0; // Draw bitplane chunks immediately
+static const int NO_DIRTY_LINES  = 0; // Colorize all lines in every frame
+static const int NO_SPR_FASTPATH = 0; // Disable sprite drawing fast path
 static const int DIAG_BOARD      = 0; // Plug in the diagnose board
 
 
@@ -303,6 +303,9 @@ class Canvas: Layer {
 
         } else {
 
+            // Take over the most recent frame (all accessors below refer to it)
+            amiga.denise.acquireFrame()
+
             // Get the emulator texture
             let buffer = amiga.denise.stableBuffer!
             let nr = amiga.denise.frameNr
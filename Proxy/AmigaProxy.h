@@ -500,11 +500,15 @@
 - (u16)sprColor:(NSInteger)nr reg:(NSInteger)reg;
 
 @property (readonly) NSInteger frameNr;
+@property (readonly) NSInteger frameSeq;
 @property (readonly) BOOL longFrame;
 @property (readonly) u32 *stableBuffer;
 @property (readonly) u32 *noise;
 
+- (void)acquireFrame;
 - (void)getStableBuffer:(u32 **)ptr nr:(i64 *)nr;
+- (BOOL)isDirtyLine:(NSInteger)line;
+- (NSInteger)waitForFrame:(NSInteger)seq timeout:(double)seconds;
 
 @end
 
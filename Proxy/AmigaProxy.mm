@@ -851,17 +851,17 @@ using namespace vamiga::moira;
 
 - (NSInteger)frameNr
 {
-    return [self denise]->pixelEngine.getStableBuffer().nr;
+    return [self denise]->pixelEngine.getConsumerBuffer().nr;
 }
 
 - (BOOL)longFrame
 {
-    return [self denise]->pixelEngine.getStableBuffer().longFrame;
+    return [self denise]->pixelEngine.getConsumerBuffer().longFrame;
 }
 
 - (u32 *)stableBuffer
 {
-    return (u32 *)([self denise]->pixelEngine.stablePtr());
+    return (u32 *)([self denise]->pixelEngine.getConsumerBuffer().pixels.ptr);
 }
 
 - (u32 *)noise
@@ -869,13 +869,34 @@ using namespace vamiga::moira;
     return (u32 *)([self denise]->pixelEngine.getNoise());
 }
 
+- (void)acquireFrame
+{
+    [self denise]->pixelEngine.acquireStableBuffer();
+}
+
 - (void)getStableBuffer:(u32 **)ptr nr:(i64 *)nr
 {
-    auto &frameBuffer = [self denise]->pixelEngine.getStableBuffer();
+    auto &frameBuffer = [self denise]->pixelEngine.acquireStableBuffer();
     *ptr = frameBuffer.pixels.ptr;
     *nr = frameBuffer.nr;
 }
 
+- (NSInteger)frameSeq
+{
+    return [self denise]->pixelEngine.getFrameSeq();
+}
+
+- (BOOL)isDirtyLine:(NSInteger)line
+{
+    return [self denise]->pixelEngine.getConsumerBuffer().dirty[line];
+}
+
+- (NSInteger)waitForFrame:(NSInteger)seq timeout:(double)seconds
+{
+    auto timeout = util::Time(i64(seconds * 1000000000.0));
+    return [self denise]->pixelEngine.waitForFrame(seq, timeout);
+}
+
 
 @end
 